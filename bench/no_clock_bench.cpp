@@ -0,0 +1,206 @@
+#define SC_INCLUDE_DYNAMIC_PROCESSES
+#include "no_clock.hpp"
+#include "no_clock_scheduler.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+// DESCRIPTION
+// Benchmark of no_clock against sc_core::sc_clock. Each run elaborates one
+// workload with N processes, simulates a fixed number of clock cycles and
+// prints a single JSON line with wall time, delta cycles, process activations
+// and peak RSS. Use run_bench.sh to sweep N and collect the results.
+//
+// Usage: no_clock_bench [--workload=W] [--clock=C] [--n=N] [--cycles=K]
+//   W = wait_posedge  - N registers in SC_THREADs clocked via wait_posedge()
+//       poll_posedge  - N SC_METHODs polling posedge() (counts the posedges seen)
+//       posedge_event - N SC_METHODs statically sensitive to posedge_event()
+//       dvfs          - wait_posedge with the frequency changed every 100 cycles
+//   C = no_clock | sc_clock (baseline)
+
+///////////////////////////////////////////////////////////////////////////////
+// $License: Apache 2.0 $
+//
+// This file is licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <systemc>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sys/resource.h>
+using namespace sc_core;
+using namespace std;
+
+namespace {
+
+  const sc_time      tPERIOD(10,SC_NS);
+  const int          STACK_SIZE    = 16*1024; // keep 1M threads affordable
+  const Clock_count_t DVFS_INTERVAL = 100;     // cycles between frequency changes
+
+  struct options_t
+  {
+    string        workload = "wait_posedge";
+    string        clock    = "no_clock";
+    size_t        n        = 1;
+    Clock_count_t cycles   = 1000;
+  };
+
+  Clock_count_t s_activations = 0; // process activations (all workloads)
+
+  //----------------------------------------------------------------------------
+  // no_clock workloads
+  void spawn_no_clock( const options_t& opt, no_clock* clk )
+  {
+    for (size_t i = 0; i != opt.n; ++i) {
+      sc_spawn_options opts;
+      if (opt.workload == "wait_posedge" or opt.workload == "dvfs") {
+        opts.set_stack_size(STACK_SIZE);
+        sc_spawn([clk](){
+          clk->wait_posedge();
+          for (;;) {
+            ++s_activations;
+            clk->wait_posedge(1);
+          }
+        }, sc_gen_unique_name("reg"), &opts);
+      } else if (opt.workload == "poll_posedge") {
+        opts.spawn_method();
+        sc_spawn([clk](){
+          if (clk->posedge()) ++s_activations;
+          next_trigger(clk->next_posedge());
+        }, sc_gen_unique_name("poll"), &opts);
+      } else if (opt.workload == "posedge_event") {
+        opts.spawn_method();
+        opts.dont_initialize();
+        opts.set_sensitivity(&clk->posedge_event());
+        sc_spawn([](){ ++s_activations; }, sc_gen_unique_name("compat"), &opts);
+      }//endif
+    }//endfor
+    if (opt.workload == "dvfs") {
+      sc_spawn_options opts;
+      sc_spawn([clk](){
+        for (bool fast = true;; fast = not fast) {
+          clk->wait_posedge(DVFS_INTERVAL);
+          clk->set_period_time(fast ? tPERIOD/2 : tPERIOD);
+        }
+      }, "governor", &opts);
+    }//endif
+  }
+
+  //----------------------------------------------------------------------------
+  // sc_clock baseline (DVFS uses a generated clock signal since sc_clock has a fixed period)
+  void spawn_sc_clock( const options_t& opt, sc_clock* clk, sc_signal<bool>* sig )
+  {
+    for (size_t i = 0; i != opt.n; ++i) {
+      sc_spawn_options opts;
+      if (opt.workload == "wait_posedge") {
+        opts.set_stack_size(STACK_SIZE);
+        sc_spawn([clk](){
+          for (;;) {
+            wait(clk->posedge_event());
+            ++s_activations;
+          }
+        }, sc_gen_unique_name("reg"), &opts);
+      } else if (opt.workload == "dvfs") {
+        opts.set_stack_size(STACK_SIZE);
+        sc_spawn([sig](){
+          for (;;) {
+            wait(sig->posedge_event());
+            ++s_activations;
+          }
+        }, sc_gen_unique_name("reg"), &opts);
+      } else if (opt.workload == "poll_posedge") {
+        opts.spawn_method(); // initialized like the no_clock variant
+        opts.set_sensitivity(&clk->value_changed_event());
+        sc_spawn([clk](){ if (clk->posedge()) ++s_activations; }, sc_gen_unique_name("poll"), &opts);
+      } else if (opt.workload == "posedge_event") {
+        opts.spawn_method();
+        opts.dont_initialize();
+        opts.set_sensitivity(&clk->posedge_event());
+        sc_spawn([](){ ++s_activations; }, sc_gen_unique_name("compat"), &opts);
+      }//endif
+    }//endfor
+    if (opt.workload == "dvfs") {
+      sc_spawn_options opts;
+      sc_spawn([sig](){
+        for (bool fast = true;; fast = not fast) {
+          const sc_time tHALF((fast ? tPERIOD : tPERIOD/2)/2);
+          for (Clock_count_t i = 0; i != DVFS_INTERVAL; ++i) {
+            sig->write(true);
+            wait(tHALF);
+            sig->write(false);
+            wait(tHALF);
+          }//endfor
+        }
+      }, "generator", &opts);
+    }//endif
+  }
+
+  //----------------------------------------------------------------------------
+  bool parse( int argc, char* argv[], options_t& opt )
+  {
+    for (int i = 1; i < argc; ++i) {
+      const char* arg = argv[i];
+      if      (strncmp(arg,"--workload=",11) == 0) opt.workload = arg+11;
+      else if (strncmp(arg,"--clock=",8)     == 0) opt.clock    = arg+8;
+      else if (strncmp(arg,"--n=",4)         == 0) opt.n        = strtoull(arg+4,nullptr,0);
+      else if (strncmp(arg,"--cycles=",9)    == 0) opt.cycles   = strtoull(arg+9,nullptr,0);
+      else return false;
+    }//endfor
+    return (opt.clock == "no_clock" or opt.clock == "sc_clock")
+       and (opt.workload == "wait_posedge" or opt.workload == "poll_posedge"
+         or opt.workload == "posedge_event" or opt.workload == "dvfs");
+  }
+
+}//endnamespace
+
+//------------------------------------------------------------------------------
+int sc_main( int argc, char* argv[] )
+{
+  options_t opt;
+  if (not parse(argc,argv,opt)) {
+    fprintf(stderr,"Usage: %s [--workload=wait_posedge|poll_posedge|posedge_event|dvfs]"
+                   " [--clock=no_clock|sc_clock] [--n=N] [--cycles=K]\n", argv[0]);
+    return 1;
+  }//endif
+  sc_report_handler::set_actions(SC_INFO, SC_DO_NOTHING);
+
+  const auto start = chrono::steady_clock::now();
+  if (opt.clock == "no_clock") {
+    spawn_no_clock(opt, no_clock::global("clk",tPERIOD));
+  } else {
+    spawn_sc_clock(opt, new sc_clock("clk",tPERIOD), new sc_signal<bool>("sig"));
+  }//endif
+  const auto elaborated = chrono::steady_clock::now();
+  sc_start(double(opt.cycles)*tPERIOD);
+  const auto finished = chrono::steady_clock::now();
+
+  const Clock_count_t notifications =
+    (opt.clock == "no_clock" and opt.workload == "posedge_event")
+    ? no_clock_scheduler::instance().notifications() : 0;
+  struct rusage usage;
+  getrusage(RUSAGE_SELF,&usage);
+  printf("{\"workload\":\"%s\",\"clock\":\"%s\",\"n\":%zu,\"cycles\":%llu"
+         ",\"elab_s\":%.6f,\"sim_s\":%.6f,\"delta_cycles\":%llu,\"activations\":%llu"
+         ",\"scheduler_notifications\":%llu,\"peak_rss_kb\":%ld}\n"
+    , opt.workload.c_str(), opt.clock.c_str(), opt.n, (unsigned long long)opt.cycles
+    , chrono::duration<double>(elaborated - start).count()
+    , chrono::duration<double>(finished - elaborated).count()
+    , (unsigned long long)sc_delta_count()
+    , (unsigned long long)s_activations
+    , (unsigned long long)notifications
+    , usage.ru_maxrss
+    );
+  return 0;
+}
+
+// TAF!
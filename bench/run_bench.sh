@@ -0,0 +1,28 @@
+#!/bin/bash
+#
+# Sweep all no_clock_bench workloads against both clocks for N = 1 .. 1M and
+# append one JSON line per run to bench_output.txt (or $1).
+#
+#   bench/run_bench.sh [output] [cycles]
+#
+# Set BENCH=<path> to use a binary other than _bench_build/no_clock_bench and
+# MAX_N to stop the sweep early.
+
+OUTPUT="${1:-bench_output.txt}"
+CYCLES="${2:-1000}"
+BENCH="${BENCH:-_bench_build/no_clock_bench}"
+MAX_N="${MAX_N:-1000000}"
+
+if [[ ! -x "${BENCH}" ]]; then
+  echo "Error: ${BENCH} not found (build with: cmake -S bench -B _bench_build && cmake --build _bench_build)" 1>&2
+  exit 1
+fi
+
+for workload in wait_posedge poll_posedge posedge_event dvfs; do
+  for clock in no_clock sc_clock; do
+    for (( n=1; n<=MAX_N; n*=10 )); do
+      "${BENCH}" --workload="${workload}" --clock="${clock}" --n="${n}" --cycles="${CYCLES}" >> "${OUTPUT}" \
+        || echo "Warning: ${workload}/${clock}/n=${n} failed" 1>&2
+    done
+  done
+done
@@ -24,7 +24,26 @@
 
 #define MSGID "/Doulos/no_clock"
 #include "no_clock_if.hpp"
-#include <map>
+#include <atomic>
+#include <initializer_list>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Query instrumentation: define NO_CLOCK_STATS (for every translation unit) to
+// count clock queries per clock and per calling process, together with a log2
+// histogram of the requested wait_* durations in cycles; the counts are reported
+// at end_of_simulation (at exit if that never comes, e.g. without sc_stop()) and
+// written as JSON. Clocks destroyed before then are not reported. Without it the
+// hooks compile to nothing.
+#ifdef NO_CLOCK_STATS
+#define NO_CLOCK_STAT(kind) count_stat(kind)
+#define NO_CLOCK_WAIT_STAT(ticks) count_wait(ticks)
+#else
+#define NO_CLOCK_STAT(kind)
+#define NO_CLOCK_WAIT_STAT(ticks)
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 //
@@ -97,6 +116,7 @@ sc_core::sc_time sc_core_time_diff
 //  assert(delay(sc_time(10,SC_NS),sc_time(3,SC_NS)) == sc_time(11,SC_NS));
 //  assert(delay(sc_time(10,SC_NS),sc_time(1,SC_NS)) == sc_time(9,SC_NS));
 //  Returns a value (0..tPERIOD-) + tOFFSET -- thus may be zero
+//  Arithmetic is done on integer ticks (sc_time::value()) -- no doubles involved
 inline sc_core::sc_time delay
 ( sc_core::sc_time tPERIOD                        // clock period
 , sc_core::sc_time tOFFSET=sc_core::SC_ZERO_TIME  // how much beyond the clock edge
@@ -122,8 +142,11 @@ inline unsigned long int clocks
 //  #     #  ####  #######  ####  #####  ####   ####  #    #                      
 //
 ////////////////////////////////////////////////////////////////////////////////
-#include "no_clock_if.h"
 typedef sc_core::sc_time (*get_time_t)(void);
+class no_clock_scheduler;
+class no_clock_hooks;
+class no_clock_bank;
+class no_clock_trace;
 class no_clock
 : public sc_core::sc_object
 , public no_clock_if
@@ -160,7 +183,52 @@ public:
   // Use following to retrieve pointer
   static no_clock* global ( const char* clock_name);
 
-  virtual ~no_clock(void) { }
+  // Use following to create a clock locked to an integer ratio of parent:
+  //   period = parent.period() * div / mul, first posedge at tPHASE
+  // Queries reuse the root clock's phase, and frequency changes of the root
+  // propagate to all derived clocks (which may not change frequency themselves).
+  // A root destroyed before its derived clocks leaves them as root clocks of their
+  // own (same period and phase, counting on from where they were).
+  static no_clock* derive
+  ( const char*      clock_instance
+  , no_clock&        parent
+  , Clock_count_t    mul
+  , Clock_count_t    div
+  , sc_core::sc_time tPHASE = sc_core::SC_ZERO_TIME
+  , double           duty   = 0.5
+  );
+  no_clock*        root      ( void ) { return m_root ? m_root : this; }
+  Clock_count_t    ratio_mul ( void ) const { return m_mul; }
+  Clock_count_t    ratio_div ( void ) const { return m_div; }
+  // Use following to resolve a global clock once and skip the name lookup afterwards
+  typedef std::size_t handle_t;
+  static handle_t  handle ( const char* clock_name );
+  static no_clock* global ( handle_t    clock_handle ) { return s_handles[clock_handle]; }
+  // Startup configuration without recompiling: "<name>.<key>=<value>" settings override
+  // the constructor arguments (and so global()) of matching clocks during construction.
+  // <name> is the hierarchical name (parent object + "." + clock name), the plain clock
+  // name or "*" (most specific wins, with period and frequency counting as one key);
+  // keys are period, frequency, duty, offset, sample and setedge, e.g.
+  //   top.cpu.clk.frequency=1.2 GHz   ddr_clk.period=1.25 ns   *.duty=0.4
+  // Sources, later settings winning: the file named by $NO_CLOCK_CONFIG (one per line,
+  // '#' comments), $NO_CLOCK_SET (';' separated) and then configure() calls. A new
+  // period keeps offset, sample and setedge at their fraction of the period; sample
+  // and setedge the original constructor computed follow a new offset or duty too.
+  // The result is validated like constructor arguments. Derived clocks follow their
+  // root and are not configured.
+  static void configure      ( const std::string& settings ); // ';' or newline separated
+  static void configure      ( int argc, const char* const* argv ); // --no_clock=<setting> or -no_clock <setting>
+  static bool configure_file ( const char* file_name );
+  // Faster elaboration of large platforms: from this call until end_of_elaboration,
+  // constructors skip their checks and global() its per clock report; all clocks are
+  // then validated in one pass with a single summary (or one fatal report listing the
+  // invalid clocks). expected preallocates the registry for that many more clocks.
+  static void defer_validation ( size_t expected = 0 );
+
+  virtual ~no_clock(void);
+
+  // Edges of interest (see until_edge, next_edge and the compatibility events)
+  enum edge_kind { POSEDGE, NEGEDGE, ANYEDGE, SAMPLE, SETEDGE };
 
   // Accessors
   void set_frequency          ( double           frequency );
@@ -170,15 +238,97 @@ public:
   void set_sample_time        ( sc_core::sc_time tSAMPLE   );
   void set_setedge_time       ( sc_core::sc_time tSETEDGE   );
   void set_time_shift         ( sc_core::sc_time tSHIFT    );
+  // Exact rational period: cycles periods take exactly tTOTAL (e.g. 3 cycles per 10 ns
+  // for 300 MHz), so cycles() never drifts with a coarse time resolution. Edges land
+  // on the first tick at or after their exact time (snapshot() queries too); period()
+  // reports the rounded period. A clock with derived clocks cannot be made rational
+  // (nor derived from while rational). set_frequency/set_period_time return to an
+  // ordinary period.
+  void set_period_ratio       ( const sc_core::sc_time& tTOTAL, Clock_count_t cycles );
+  bool is_rational            ( void ) const { return m_period_den != 1; }
+  // Modulation (spread spectrum, jitter): profile[k] is the period of cycle k of a
+  // frame that repeats from now on. The frame is summed into an edge table once,
+  // so queries are a binary search with no per-cycle state changes. Edges keep
+  // their fraction of each cycle. period() and snapshot() use the nominal period,
+  // cycles(t) before a later change uses the frame's mean period. A clock with
+  // derived clocks cannot be modulated (nor derived from while modulated).
+  // set_frequency, set_period_time, set_period_ratio and clear_modulation end it.
+  void set_modulation         ( const std::vector<sc_core::sc_time>& profile );
+  void clear_modulation       ( void );
+  bool is_modulated           ( void ) const { return not m_mod_period.empty(); }
+  // Profiles for set_modulation
+  static std::vector<sc_core::sc_time> ssc_profile // triangular down-spread: frequency sweeps f..f*(1-spread)..f
+  ( const sc_core::sc_time& tPERIOD, double spread, size_t cycles );
+  static std::vector<sc_core::sc_time> jitter_profile // period jitter uniform in [-tJITTER,+tJITTER] (repeatable)
+  ( const sc_core::sc_time& tPERIOD, const sc_core::sc_time& tJITTER, size_t cycles, unsigned seed = 1U );
+  // Clock gating: while gated there are no edges (at_*_time() and read() are false,
+  // compatibility events stay quiet) and cycles() holds its value. wait_* callers
+  // sleep on a single event until ungate() and then continue at the next aligned
+  // edge; until_*/next_* keep reporting the ungated phase. Gating a root clock
+  // also gates the clocks derived from it.
+  void gate                   ( void );
+  void ungate                 ( void );
+  bool gated                  ( void ) const { return m_gated; }
   const char*      name       ( void ) const;
   sc_core::sc_time period     ( Clock_count_t cycles = 1 ) const;
   double           duty       ( void ) const;
   double           frequency  ( void ) const;
   sc_core::sc_time time_shift ( void ) const { return m_tSHIFT; }
+  const char*      clock_name ( void ) const override { return m_clock_name; }
   // Special conveniences
   Clock_count_t     cycles ( void ) const; // Number of clock cycles since start
-  void             reset  ( void ); // Clears count & frequency change base (not yet implemented -- specification issues remain)
+  Clock_count_t     cycles ( sc_core::sc_time t ) const; // Number of clock cycles at time t
+  void             reset  ( void ); // Clears count & frequency change history (cycles() restarts from 0 now; root clocks only)
   Clock_count_t     frequency_changes ( void ) const { return m_freq_count; } // Number of times frequency was changed
+  sc_core::sc_time  cycle_time ( Clock_count_t cycle ) const; // Time when cycles() reaches cycle (inverse of cycles(t))
+  // Frequency change history (O(log n) lookup for cycles(t) and cycle_time(n) in the past)
+  struct segment_t
+  {
+    sc_dt::uint64 time;       // ticks when period took effect
+    sc_dt::uint64 period;     // ticks (per den cycles)
+    Clock_count_t base_count; // cycles() at time
+    sc_dt::uint64 den;        // 1 unless set_period_ratio
+  };
+  const std::vector<segment_t>& history ( void ) const { return m_history; } // oldest first
+  void   set_history_depth ( size_t depth ); // keep at least depth segments (0 = unlimited)
+  size_t history_depth     ( void ) const { return m_history_depth; }
+  // Checkpoint/restore (e.g. boot once, then warm-start many runs): a compact binary
+  // record of timing, gating, cycle count and phase. restore() rebases the record onto
+  // sc_time_stamp(): the clock resumes at the start of the cycle that was in progress
+  // (of the frame, for rational and modulated clocks) with the same count and edge
+  // phase. Restore derived clocks after their root. The time resolution must match,
+  // and history before the checkpoint is not kept.
+  void        save           ( std::ostream& os ) const;
+  bool        restore        ( std::istream& is ); // false (after a warning, clock untouched) if unusable
+  static void save_global    ( std::ostream& os ); // every clock in the global registry
+  static bool restore_global ( std::istream& is ); // creates global clocks that do not exist yet; false at
+                                                   // the first unusable record (earlier ones stay restored)
+  // Consistent copy of the timing parameters that may be taken from any OS thread
+  // (e.g. co-simulation or async_request_update side threads) without locking;
+  // queries take an explicit absolute time since sc_time_stamp() is not thread safe
+  struct snapshot_t
+  {
+    sc_dt::uint64 period;        // ticks
+    sc_dt::uint64 posedge;       // ticks into period
+    sc_dt::uint64 negedge;
+    sc_dt::uint64 sample;
+    sc_dt::uint64 setedge;
+    sc_dt::uint64 count_period;  // period used for counting (root period if derived)
+    sc_dt::uint64 frequency_set; // ticks when count_period took effect
+    Clock_count_t base_count;    // count at frequency_set
+    Clock_count_t mul;           // derived clocks: cycles = root cycles * mul / div
+    Clock_count_t div;
+    Clock_count_t freq_count;
+    bool          gated;         // cycles() holds at base_count
+    sc_dt::uint64 period_num;    // exact period is period_num/period_den ticks
+    sc_dt::uint64 period_den;    // 1 unless set_period_ratio
+    Clock_count_t cycles     ( sc_dt::uint64 t ) const;
+    sc_dt::uint64 until_edge ( edge_kind kind, sc_dt::uint64 t, Clock_count_t cycles = 0U ) const; // ticks
+    bool          read       ( sc_dt::uint64 t ) const;
+    Clock_count_t exact_cycles     ( sc_dt::uint64 t ) const; // rational period (see no_clock::exact_cycles)
+    sc_dt::uint64 exact_until_edge ( edge_kind kind, sc_dt::uint64 t, Clock_count_t cycles ) const;
+  };
+  snapshot_t snapshot ( void ) const; // seqlock read: retries only while a write is in progress
   // Calculate the delay till... (use for temporal offset)...may return SC_ZERO_TIME if already on the edge
   sc_core::sc_time  until_posedge ( Clock_count_t cycles = 0U ) const;
   sc_core::sc_time  until_negedge ( Clock_count_t cycles = 0U ) const;
@@ -191,12 +341,126 @@ public:
   sc_core::sc_time  next_anyedge ( Clock_count_t cycles = 0U ) const;
   sc_core::sc_time  next_sample  ( Clock_count_t cycles = 0U ) const;
   sc_core::sc_time  next_setedge ( Clock_count_t cycles = 0U ) const;
+  // Same as above selected by edge_kind
+  sc_core::sc_time  until_edge   ( edge_kind kind, Clock_count_t cycles = 0U ) const;
+  sc_core::sc_time  next_edge    ( edge_kind kind, Clock_count_t cycles = 0U ) const;
+  // Same as above as if set_time_shift(tSHIFT) (e.g. local time of a temporally decoupled
+  // initiator) without modifying the shared clock; use cycles(sc_time_stamp()+tSHIFT) for the count
+  sc_core::sc_time  until_edge    ( edge_kind kind, Clock_count_t cycles, const sc_core::sc_time& tSHIFT ) const;
+  sc_core::sc_time  next_edge     ( edge_kind kind, Clock_count_t cycles, const sc_core::sc_time& tSHIFT ) const;
+  sc_core::sc_time  until_posedge ( Clock_count_t cycles, const sc_core::sc_time& tSHIFT ) const { return until_edge(POSEDGE,cycles,tSHIFT); }
+  sc_core::sc_time  until_negedge ( Clock_count_t cycles, const sc_core::sc_time& tSHIFT ) const { return until_edge(NEGEDGE,cycles,tSHIFT); }
+  sc_core::sc_time  until_anyedge ( Clock_count_t cycles, const sc_core::sc_time& tSHIFT ) const { return until_edge(ANYEDGE,cycles,tSHIFT); }
+  sc_core::sc_time  until_sample  ( Clock_count_t cycles, const sc_core::sc_time& tSHIFT ) const { return until_edge(SAMPLE,cycles,tSHIFT);  }
+  sc_core::sc_time  until_setedge ( Clock_count_t cycles, const sc_core::sc_time& tSHIFT ) const { return until_edge(SETEDGE,cycles,tSHIFT); }
+  sc_core::sc_time  next_posedge  ( Clock_count_t cycles, const sc_core::sc_time& tSHIFT ) const { return next_edge(POSEDGE,cycles,tSHIFT);  }
+  sc_core::sc_time  next_negedge  ( Clock_count_t cycles, const sc_core::sc_time& tSHIFT ) const { return next_edge(NEGEDGE,cycles,tSHIFT);  }
+  sc_core::sc_time  next_anyedge  ( Clock_count_t cycles, const sc_core::sc_time& tSHIFT ) const { return next_edge(ANYEDGE,cycles,tSHIFT);  }
+  sc_core::sc_time  next_sample   ( Clock_count_t cycles, const sc_core::sc_time& tSHIFT ) const { return next_edge(SAMPLE,cycles,tSHIFT);   }
+  sc_core::sc_time  next_setedge  ( Clock_count_t cycles, const sc_core::sc_time& tSHIFT ) const { return next_edge(SETEDGE,cycles,tSHIFT);  }
+  // Batch form of until_*: out[k] = until_*(k) for k in [0,n) -- one modulo, then a stride
+  void posedge_times ( sc_core::sc_time* out, size_t n ) const { edge_times(POSEDGE,out,n); }
+  void negedge_times ( sc_core::sc_time* out, size_t n ) const { edge_times(NEGEDGE,out,n); }
+  void sample_times  ( sc_core::sc_time* out, size_t n ) const { edge_times(SAMPLE,out,n);  }
+  void setedge_times ( sc_core::sc_time* out, size_t n ) const { edge_times(SETEDGE,out,n); }
+  void edge_times    ( edge_kind kind, sc_core::sc_time* out, size_t n ) const;
+  void edge_times    ( edge_kind kind, sc_dt::uint64*    out, size_t n ) const; // raw ticks
   // Wait only if really necessary (for use in SC_THREAD)
+  void wait         ( Clock_count_t cycles = 0U ) { wait_posedge(cycles); }
   void wait_posedge ( Clock_count_t cycles = 0U );
   void wait_negedge ( Clock_count_t cycles = 0U );
   void wait_anyedge ( Clock_count_t cycles = 0U );
   void wait_sample  ( Clock_count_t cycles = 0U );
   void wait_setedge ( Clock_count_t cycles = 0U );
+  void wait_edge    ( edge_kind kind, Clock_count_t cycles = 0U );
+  // Skip idle cycles (for use in SC_THREAD)
+  void wait_until_cycle ( Clock_count_t cycle ); // until cycles() >= cycle (follows frequency changes)
+  void wait_aligned     ( const sc_core::sc_event& event, edge_kind kind = POSEDGE ); // event, then next edge of kind
+  // Cycle accounting for cycle-approximate models: add() is integer arithmetic only,
+  // and the calling thread synchronizes (wait_until_cycle, so frequency changes made
+  // meanwhile are honoured) only once quantum cycles have accumulated or on sync()
+  class cycle_budget
+  {
+  public:
+    explicit cycle_budget ( no_clock& clock, Clock_count_t quantum = 0U ) // 0: only sync() waits
+    : m_clock(clock), m_quantum(quantum), m_origin(clock.cycles()), m_pending(0U) { }
+    void add ( Clock_count_t cycles ) { m_pending += cycles; if (m_quantum != 0U and m_pending >= m_quantum) sync(); }
+    void sync    ( void ); // SC_THREAD: wait until cycles() reaches target()
+    void restart ( void ) { m_origin = m_clock.cycles(); m_pending = 0U; } // drop pending (e.g. after other waits)
+    Clock_count_t    pending    ( void ) const { return m_pending; }
+    Clock_count_t    target     ( void ) const { return m_origin + m_pending; } // cycle the model has reached
+    sc_core::sc_time local_time ( void ) const; // until target() (e.g. a TLM delay annotation), converted on demand
+    no_clock&        clock      ( void ) const { return m_clock; }
+  private:
+    no_clock&     m_clock;
+    Clock_count_t m_quantum;
+    Clock_count_t m_origin;  // cycles() at the last sync
+    Clock_count_t m_pending; // added since
+  };
+  // Earliest edge among several clocks, computed from phase alone (no events);
+  // ties go to the first clock listed, gated clocks are skipped and an empty
+  // list (or all gated) yields a nullptr clock. wait_any also wakes up to look
+  // again when a listed clock is ungated (the only wakeup while all are gated),
+  // so it returns nullptr only for an empty list.
+  struct any_edge_t
+  {
+    sc_core::sc_time delay;
+    no_clock*        clock; // the one that gets there first
+  };
+  static any_edge_t until_any ( std::initializer_list<no_clock*> clocks, edge_kind kind = POSEDGE, Clock_count_t cycles = 0U );
+  static any_edge_t next_any  ( std::initializer_list<no_clock*> clocks, edge_kind kind = POSEDGE, Clock_count_t cycles = 0U );
+  static any_edge_t until_any ( no_clock* const* clocks, size_t n, edge_kind kind = POSEDGE, Clock_count_t cycles = 0U );
+  static any_edge_t next_any  ( no_clock* const* clocks, size_t n, edge_kind kind = POSEDGE, Clock_count_t cycles = 0U );
+  static no_clock*  wait_any  ( std::initializer_list<no_clock*> clocks, edge_kind kind = POSEDGE ); // returns the winner
+  static no_clock*  wait_any  ( no_clock* const* clocks, size_t n, edge_kind kind = POSEDGE );
+  // Same as wait_* for C++20 coroutines driven by an SC_METHOD (see no_clock_coro.hpp):
+  //   co_await clk.posedge_awaitable(n);
+  // resumes at once if already on the edge, otherwise the method sleeps with
+  // next_trigger() (and through gating, like wait_*). No thread stack is needed.
+  struct edge_awaitable_t
+  {
+    no_clock*     clock;
+    edge_kind     kind;
+    Clock_count_t cycles;
+    bool          gated;  // asleep on m_ungate_event
+    bool await_ready  ( void ) { return clock->await_ready(*this); }
+    template<class Handle> // Handle::promise() must have an edge_awaitable_t* waiting (see no_clock_task)
+    void await_suspend ( Handle h ) { h.promise().waiting = this; clock->await_suspend(*this); }
+    void await_resume ( void ) const { }
+    bool poll         ( void ) { return clock->await_poll(*this); } // each activation: true to resume
+  };
+  edge_awaitable_t edge_awaitable    ( edge_kind kind, Clock_count_t cycles = 0U ) { edge_awaitable_t a = { this, kind, cycles, false }; return a; }
+  edge_awaitable_t posedge_awaitable ( Clock_count_t cycles = 0U ) { return edge_awaitable(POSEDGE,cycles); }
+  edge_awaitable_t negedge_awaitable ( Clock_count_t cycles = 0U ) { return edge_awaitable(NEGEDGE,cycles); }
+  edge_awaitable_t anyedge_awaitable ( Clock_count_t cycles = 0U ) { return edge_awaitable(ANYEDGE,cycles); }
+  edge_awaitable_t sample_awaitable  ( Clock_count_t cycles = 0U ) { return edge_awaitable(SAMPLE,cycles);  }
+  edge_awaitable_t setedge_awaitable ( Clock_count_t cycles = 0U ) { return edge_awaitable(SETEDGE,cycles); }
+  // Setup/hold checking without events: this clock samples at tSAMPLE (hold is met
+  // after it) and data must be written by tSETEDGE (setup), so writes are legal in
+  // [sample, setedge] of each cycle. slack is in ticks: the margin to the nearer
+  // window boundary if ok, otherwise minus the distance into the window to the nearer
+  // violated requirement. Write times are absolute; a gated clock samples nothing.
+  struct window_check_t
+  {
+    bool          ok;
+    sc_dt::int64  slack; // ticks
+    bool          setup; // nearer boundary is the setedge (else the sample)
+  };
+  window_check_t check_window   ( const sc_core::sc_time& tWRITE ) const;
+  void           check_window   ( const sc_dt::uint64* write_ticks, window_check_t* out, size_t n ) const; // batch
+  void           check_crossing // writes at the next n setedges of writer at or after tFROM
+  ( const no_clock& writer, const sc_core::sc_time& tFROM, window_check_t* out, size_t n ) const;
+  // Notify event at until_*(cycles) (never blocks: use from SC_METHOD or during elaboration);
+  // measured from sc_time_stamp() like the compatibility events, i.e. without the time shift
+  void notify_at_edge    ( sc_core::sc_event& event, edge_kind kind, Clock_count_t cycles = 0U ) const
+  {
+    event.notify(sc_core::sc_time::from_value(event_delay_ticks(kind,cycles,true)));
+  }
+  void notify_at_posedge ( sc_core::sc_event& event, Clock_count_t cycles = 0U ) const { notify_at_edge(event,POSEDGE,cycles); }
+  void notify_at_negedge ( sc_core::sc_event& event, Clock_count_t cycles = 0U ) const { notify_at_edge(event,NEGEDGE,cycles); }
+  void notify_at_anyedge ( sc_core::sc_event& event, Clock_count_t cycles = 0U ) const { notify_at_edge(event,ANYEDGE,cycles); }
+  void notify_at_sample  ( sc_core::sc_event& event, Clock_count_t cycles = 0U ) const { notify_at_edge(event,SAMPLE,cycles);  }
+  void notify_at_setedge ( sc_core::sc_event& event, Clock_count_t cycles = 0U ) const { notify_at_edge(event,SETEDGE,cycles); }
   // Are we there? (use in SC_METHOD)
   bool at_posedge_time ( void ) const;
   bool posedge         ( void ) const { return at_posedge_time(); }
@@ -208,6 +472,16 @@ public:
   bool at_setedge_time ( void ) const;
   // For compatibility if you really have/want to (with an extra feature)
   // - specify N > 0 to delay further out
+  // - edges are those of sc_time_stamp(): the events are shared, so the time
+  //   shift (set_time_shift) does not apply to them
+  // - never blocks the caller:
+  //   * Requested during elaboration (e.g. sensitive << clk.posedge_event()) the
+  //     event is notified on every edge by the shared no_clock_scheduler, for as
+  //     long as the process declared last (the one made sensitive) has not terminated.
+  //   * Requested during simulation (e.g. wait(clk.posedge_event())) the event
+  //     is notified once at next_edge(kind,N) unless already scheduled as above.
+  //     On the edge itself that is the following edge (unlike wait_posedge(),
+  //     which returns at once), so such a wait always advances.
   sc_core::sc_event& default_event       ( size_t events = 0 ) override;
   sc_core::sc_event& posedge_event       ( size_t events = 0 ) override;
   sc_core::sc_event& negedge_event       ( size_t events = 0 ) override;
@@ -220,10 +494,106 @@ public:
   virtual sc_core::sc_time delay( sc_core::sc_time tPERIOD, sc_core::sc_time tOFFSET, sc_core::sc_time tSHIFT) const override;
   virtual Clock_count_t clocks( sc_core::sc_time tPERIOD, sc_core::sc_time tZERO, sc_core::sc_time tSHIFT) const override;
 
+  // Query instrumentation (only counted if built with NO_CLOCK_STATS)
+  enum stat_kind
+  { STAT_UNTIL     // until_*
+  , STAT_NEXT      // next_*
+  , STAT_WAIT      // wait_*
+  , STAT_AT        // at_*_time, posedge(), negedge(), event()
+  , STAT_READ      // read()
+  , STAT_EVENT     // compatibility events (posedge_event() etc.)
+  , STAT_SUSPEND   // actual sc_core::wait() calls made by wait_*
+  , STAT_ZERO_WAIT // wait_* that returned without suspending
+  , STAT_KINDS
+  };
+  // waits[0] counts requests for less than one cycle, waits[b] for [2^(b-1),2^b) cycles
+  enum { WAIT_BUCKETS = 65 };
+  struct stats_t { Clock_count_t count[STAT_KINDS]; Clock_count_t waits[WAIT_BUCKETS]; };
+  const stats_t* stats        ( void ) const; // totals (nullptr if nothing counted)
+  void           report_stats ( void ) const; // totals and per process (also done at end_of_simulation)
+  // All clocks as JSON (also written at end_of_simulation to $NO_CLOCK_STATS_JSON,
+  // default no_clock_stats.json)
+  static void    write_stats_json ( std::ostream& os );
+
 private:
+  friend class no_clock_scheduler;
+  friend class no_clock_hooks;
+  friend class no_clock_bank; // companion clocks (see no_clock_bank::sync)
+  friend class no_clock_trace; // analytic VCD (see no_clock_trace.hpp)
+  typedef void (*change_hook_t)( const no_clock& clock, bool destroyed );
+  void               before_change  ( bool destroyed = false ) const { if (s_change_hook) s_change_hook(*this,destroyed); } // timing is about to change
+  void               count_stat     ( stat_kind kind ) const; // see NO_CLOCK_STAT
+  void               count_wait     ( sc_dt::uint64 ticks ) const; // see NO_CLOCK_WAIT_STAT
+  stats_t&           process_stats  ( void ) const; // current process' entry (allocates m_stats)
+  void               suspend        ( sc_dt::uint64 ticks, edge_kind kind, Clock_count_t cycles ); // wait_* common tail
+  void               wait_ungated   ( edge_kind kind, Clock_count_t cycles ); // sleep through gating, then realign
+  sc_dt::uint64      wait_ticks     ( edge_kind kind, Clock_count_t cycles ) const; // what wait_edge would sleep
+  bool               await_ready    ( edge_awaitable_t& awaitable ); // see edge_awaitable_t
+  void               await_suspend  ( edge_awaitable_t& awaitable );
+  bool               await_poll     ( edge_awaitable_t& awaitable );
+  void               set_gated      ( bool gated ); // gate/ungate (also derived clocks)
+  void               release_gated  ( void ); // set_gated(false) tail: notify the gated waiters
+  sc_core::sc_event& edge_event     ( edge_kind kind, size_t events ); // compatibility events
+  sc_core::sc_event& edge_event_ref ( edge_kind kind ); // just the member
+  sc_dt::uint64      edge_ticks     ( edge_kind kind, sc_dt::uint64 t, bool inclusive = false ) const; // absolute time of next edge after (or at) t
+  void               change_period  ( const sc_core::sc_time& tPERIOD, sc_dt::uint64 num = 0, sc_dt::uint64 den = 1 ); // set_frequency/set_period_time/set_period_ratio
+  void               record_segment ( void ); // append current period to m_history
+  const segment_t&   find_segment   ( sc_dt::uint64 t ) const; // segment in effect at t (binary search)
+  void               follow_root    ( void ); // derived clock: take period from m_root
+  void               detach         ( void ); // derived clock: m_root is being destroyed
+  void               set_follow_base ( void ); // derived clock: edges follow_root scales from
+  Clock_count_t      derived_count  ( Clock_count_t root_cycles ) const // root_cycles * m_mul / m_div without overflow
+  {
+    return ( root_cycles / m_div ) * m_mul + ( root_cycles % m_div ) * m_mul / m_div;
+  }
+  struct checkpoint_t;                        // see no_clock_checkpoint.cpp
+  void               rebase         ( const checkpoint_t& saved ); // restore() after validation
+  static bool        read_checkpoint ( std::istream& is, checkpoint_t& saved ); // one validated record
+  void               apply_config   ( bool default_edges ); // constructors: settings for this clock (see configure)
+  window_check_t     window_ticks   ( sc_dt::uint64 w ) const; // check_window
+  bool               last_edge_ticks ( edge_kind kind, sc_dt::uint64 t, sc_dt::uint64& edge ) const; // latest edge at or before t
+  const char*        timing_error   ( void ) const; // first failed constructor check (nullptr if valid)
+  void               validate       ( void ) const; // SC_REPORT_FATAL on timing_error()
+  static void        validate_deferred ( void ); // end_of_elaboration (see defer_validation)
+  static Clock_count_t segment_cycles ( const segment_t& segment, sc_dt::uint64 t ); // cycles() at t >= segment.time
+  static sc_dt::uint64 segment_time   ( const segment_t& segment, Clock_count_t cycle ); // inverse of the above
+  // Rational or modulated period (see set_period_ratio, set_modulation)
+  Clock_count_t      exact_cycles      ( sc_dt::uint64 t ) const; // cycles at t >= m_frequency_set
+  sc_dt::uint64      exact_cycle_time  ( Clock_count_t cycle ) const; // inverse of the above
+  sc_dt::uint64      modulated_delay_ticks ( sc_dt::uint64 offset, sc_dt::uint64 t, Clock_count_t cycles, bool inclusive ) const;
+  Clock_count_t      modulated_index   ( sc_dt::uint64 t ) const; // cycle starts in (m_mod_origin,t]
+  sc_dt::uint64      exact_delay_ticks ( edge_kind kind, sc_dt::uint64 t, Clock_count_t cycles, bool inclusive ) const; // from absolute t
+  sc_dt::uint64      exact_delay_ticks ( edge_kind kind, Clock_count_t cycles, bool inclusive ) const // from now + shift
+  {
+    return exact_delay_ticks(kind, sc_core::sc_time_stamp().value() + m_shift_ticks, cycles, inclusive);
+  }
+  // Integer tick fast path (all values in units of sc_get_time_resolution())
+  void          update_ticks ( void ); // refresh cached ticks from sc_time members
+  void          publish      ( void ); // update the seqlocked snapshot (SystemC thread only)
+  sc_dt::uint64 phase_ticks  ( void ) const; // (now + shift) % period
+  // Per-delta memoization of the current phase
+  struct phase_cache_t
+  {
+    sc_dt::uint64 stamp;      // key: sc_time_stamp() ticks
+    sc_dt::uint64 delta;      // key: sc_delta_count()
+    Clock_count_t freq_count; // key: m_freq_count
+    sc_dt::uint64 shift;      // key: m_shift_ticks
+    sc_dt::uint64 quotient;   // (now + shift) / period
+    sc_dt::uint64 remainder;  // (now + shift) % period
+    Clock_count_t cycles;     // cycles()
+    bool          level;      // read()
+    bool          valid;
+  };
+  const phase_cache_t& phase ( void ) const; // refresh if stale
+  void invalidate_phase ( void ) { m_phase.valid = false; }
+  sc_dt::uint64 delay_ticks  ( sc_dt::uint64 offset ) const; // until next offset into period (may be 0)
+  sc_dt::uint64 delay_ticks  ( sc_dt::uint64 remainder, sc_dt::uint64 offset ) const; // given phase_ticks()
+  sc_dt::uint64 edge_delay_ticks ( edge_kind kind, sc_dt::uint64 remainder, bool inclusive ) const; // until_edge/next_edge
+  sc_dt::uint64 event_delay_ticks ( edge_kind kind, Clock_count_t cycles, bool inclusive ) const; // from sc_time_stamp() without m_tSHIFT (kernel events)
+  sc_dt::uint64 phase_ticks  ( sc_dt::uint64 shift ) const; // (now + shift) % period
   // Don't allow copying
-  no_clock(no_clock& disallowed __attribute__((unused))) {} // Copy constructor
-  no_clock& operator= (no_clock& disallowed) {return disallowed;} // Assignment
+  no_clock ( const no_clock& ) = delete; // Copy constructor
+  no_clock& operator= ( const no_clock& ) = delete; // Assignment
   // Internal data
   get_time_t          m_get_time;// callback that returns current time
   const char *        m_clock_name;// clock name
@@ -240,12 +610,66 @@ private:
   sc_core::sc_event   m_negedge_event;
   sc_core::sc_event   m_sample_event;
   sc_core::sc_event   m_setedge_event;
+  unsigned            m_subscribed; // bit per edge_kind driven by no_clock_scheduler
+  struct sensitive_t
+  {
+    edge_kind                  kind;
+    sc_core::sc_process_handle process; // subscribed on behalf of (invalid: no process yet)
+  };
+  std::vector<sensitive_t> m_sensitive; // owners of the m_subscribed edges
+  sc_core::sc_event   m_timing_changed_event; // period or cycle base changed (see wait_until_cycle)
+  unsigned            m_cycle_waiters; // threads asleep in wait_until_cycle (see reset)
+  Clock_count_t       m_schedule_generation; // invalidates stale no_clock_scheduler entries
   sc_core::sc_time    m_frequency_set; // time when period was last changed
   unsigned long int   m_freq_count;    // counts how many times frequency was changed
   unsigned long int   m_base_count;    // cycles up to last frequency change
+  std::vector<segment_t> m_history;    // append-only (apart from trimming) record of period changes
+  size_t              m_history_depth; // 0 = unlimited
+  bool                m_history_trimmed; // set_history_depth dropped segments
+  no_clock*           m_root;          // derived from (nullptr if this is a root)
+  Clock_count_t       m_mul;           // period = m_root period * m_div / m_mul
+  Clock_count_t       m_div;
+  bool                m_exact_ratio;   // period*m_mul == m_root period*m_div in ticks
+  sc_dt::uint64       m_follow_period;  // derived clock: period the edges below were set for
+  sc_dt::uint64       m_follow_offset;  // (see set_follow_base)
+  sc_dt::uint64       m_follow_sample;
+  sc_dt::uint64       m_follow_setedge;
+  std::vector<no_clock*> m_derived;    // clocks with m_root == this
   sc_core::sc_time    m_tSHIFT;  // temporal shift
-  typedef std::map<const char*,no_clock*> clock_map_t;
-  static clock_map_t  s_global;
+  // Cached copies of the above as raw ticks (see update_ticks)
+  sc_dt::uint64       m_period_ticks;
+  sc_dt::uint64       m_posedge_ticks; // normalized to [0,period)
+  sc_dt::uint64       m_negedge_ticks; // normalized to [0,period)
+  sc_dt::uint64       m_sample_ticks;
+  sc_dt::uint64       m_setedge_ticks;
+  sc_dt::uint64       m_shift_ticks;
+  sc_dt::uint64       m_period_num; // exact period is m_period_num/m_period_den ticks
+  sc_dt::uint64       m_period_den; // 1 unless set_period_ratio
+  bool                m_irregular;      // rational or modulated: queries use exact_delay_ticks
+  std::vector<sc_dt::uint64> m_mod_period; // modulation frame: period of each cycle (empty if none)
+  std::vector<sc_dt::uint64> m_mod_start;  // start of each cycle within the frame (plus frame length)
+  sc_dt::uint64       m_mod_origin;     // ticks when frame 0 began
+  bool                m_gated;          // see gate()
+  unsigned            m_gated_requests; // bit per edge_kind: one-shot events requested while gated
+  sc_core::sc_event   m_ungate_event;   // the only wakeup for gated wait_* callers
+  mutable phase_cache_t m_phase; // see phase()
+  // Seqlock protected copy of snapshot_t (odd m_seq = write in progress)
+  enum { SNAP_PERIOD, SNAP_POSEDGE, SNAP_NEGEDGE, SNAP_SAMPLE, SNAP_SETEDGE, SNAP_COUNT_PERIOD
+       , SNAP_FREQUENCY_SET, SNAP_BASE_COUNT, SNAP_MUL, SNAP_DIV, SNAP_FREQ_COUNT, SNAP_GATED
+       , SNAP_PERIOD_NUM, SNAP_PERIOD_DEN, SNAP_FIELDS };
+  std::atomic<unsigned>      m_seq;
+  std::atomic<sc_dt::uint64> m_snap[SNAP_FIELDS];
+  struct stats_table_t;           // see no_clock.cpp
+  mutable stats_table_t* m_stats; // allocated on first count (nullptr without NO_CLOCK_STATS)
+  // Global registry: interned names (keys own the storage seen by name()) -> handle
+  typedef std::unordered_map<std::string,handle_t> clock_map_t;
+  static clock_map_t            s_global;
+  static std::vector<no_clock*> s_handles; // indexed by handle_t
+  static std::vector<no_clock*> s_instances; // every live clock (global or not)
+  static change_hook_t          s_change_hook; // installed by no_clock_trace
+  static bool                   s_deriving;    // derive() is constructing (skip apply_config)
+  static bool                   s_defer;       // see defer_validation
+  static size_t                 s_deferred_globals;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -262,7 +686,12 @@ private:
 // For efficiency
 
 //------------------------------------------------------------------------------
-inline void no_clock::set_time_shift (sc_core::sc_time tSHIFT) { m_tSHIFT = tSHIFT; }
+inline void no_clock::set_time_shift (sc_core::sc_time tSHIFT)
+{
+  m_tSHIFT      = tSHIFT;
+  m_shift_ticks = tSHIFT.value();
+  invalidate_phase();
+}
 
 //------------------------------------------------------------------------------
 inline sc_core::sc_time delay
@@ -271,10 +700,12 @@ inline sc_core::sc_time delay
 , sc_core::sc_time tSHIFT  // temporal offset to assume
 )
 {
-  sc_core::sc_time tREMAINDER = (sc_core::sc_time_stamp() + tSHIFT) % tPERIOD;
-  if      ( tREMAINDER == tOFFSET ) return sc_core::SC_ZERO_TIME;
-  else if ( tREMAINDER <  tOFFSET ) return tOFFSET - tREMAINDER;
-  else                              return tPERIOD + tOFFSET - tREMAINDER;
+  const sc_dt::uint64 period    = tPERIOD.value();
+  const sc_dt::uint64 offset    = tOFFSET.value();
+  const sc_dt::uint64 remainder = (sc_core::sc_time_stamp().value() + tSHIFT.value()) % period;
+  if      ( remainder == offset ) return sc_core::SC_ZERO_TIME;
+  else if ( remainder <  offset ) return sc_core::sc_time::from_value( offset - remainder );
+  else                            return sc_core::sc_time::from_value( period + offset - remainder );
 }
 
 //------------------------------------------------------------------------------
@@ -285,15 +716,148 @@ inline unsigned long int clocks
 , sc_core::sc_time tSHIFT
 )
 {
-  // TODO: Factor in frequency changes
-  return (unsigned long int)(( sc_core::sc_time_stamp() + tSHIFT - tZERO ) / tPERIOD);
+  // Assumes a fixed period; no_clock::cycles() accounts for frequency changes
+  return (unsigned long int)
+    (( sc_core::sc_time_stamp().value() + tSHIFT.value() - tZERO.value() ) / tPERIOD.value());
+}
+
+//------------------------------------------------------------------------------
+// Integer tick fast path
+//------------------------------------------------------------------------------
+// Repeated queries within one delta cycle only pay for the key comparison
+inline const no_clock::phase_cache_t& no_clock::phase ( void ) const
+{
+  const sc_dt::uint64 stamp = sc_core::sc_time_stamp().value();
+  const sc_dt::uint64 delta = sc_core::sc_delta_count();
+  if ( m_phase.valid
+   and m_phase.stamp      == stamp
+   and m_phase.delta      == delta
+   and m_phase.freq_count == m_freq_count
+   and m_phase.shift      == m_shift_ticks
+  ) {
+    return m_phase;
+  }//endif
+  const sc_dt::uint64 now = stamp + m_shift_ticks;
+  m_phase.stamp      = stamp;
+  m_phase.delta      = delta;
+  m_phase.freq_count = m_freq_count;
+  m_phase.shift      = m_shift_ticks;
+  if (m_irregular) {
+    // Rational or modulated: no common remainder, every query takes the exact path
+    m_phase.quotient  = now / m_period_ticks;
+    m_phase.remainder = now % m_period_ticks;
+    m_phase.cycles    = exact_cycles(now);
+    m_phase.level     = exact_delay_ticks(NEGEDGE,now,0,true) < exact_delay_ticks(POSEDGE,now,0,true);
+    if (m_gated) {
+      m_phase.cycles = m_base_count;
+      m_phase.level  = false;
+    }//endif
+    m_phase.valid     = true;
+    return m_phase;
+  }//endif
+  if (m_root == nullptr) {
+    m_phase.quotient  = now / m_period_ticks;
+    m_phase.remainder = now % m_period_ticks;
+    m_phase.cycles    = m_base_count + ( now - m_frequency_set.value() ) / m_period_ticks;
+  } else if (m_shift_ticks != m_root->m_shift_ticks) {
+    // Derived clock with a shift of its own: the root's phase is for another time
+    m_phase.quotient  = now / m_period_ticks;
+    m_phase.remainder = now % m_period_ticks;
+    m_phase.cycles    = derived_count(m_root->cycles(sc_core::sc_time::from_value(now)));
+  } else {
+    // Derived clock: reuse the root's phase. root period * div == period * mul, so with
+    // within = (q % div) * root period + r (< period * mul) now is (q / div) * mul periods + within
+    const phase_cache_t& root(m_root->phase());
+    if (m_exact_ratio) {
+      const sc_dt::uint64 within = ( root.quotient % m_div ) * m_root->m_period_ticks + root.remainder;
+      m_phase.quotient  = ( root.quotient / m_div ) * m_mul + within / m_period_ticks;
+      m_phase.remainder = within % m_period_ticks;
+    } else {
+      m_phase.quotient  = now / m_period_ticks;
+      m_phase.remainder = now % m_period_ticks;
+    }//endif
+    m_phase.cycles    = derived_count(root.cycles);
+  }//endif
+  m_phase.level      = delay_ticks(m_phase.remainder,m_negedge_ticks)
+                     < delay_ticks(m_phase.remainder,m_posedge_ticks);
+  if (m_gated) {
+    // Derived clocks already hold through the root's count
+    if (m_root == nullptr) m_phase.cycles = m_base_count;
+    m_phase.level = false;
+  }//endif
+  m_phase.valid      = true;
+  return m_phase;
+}
+
+inline sc_dt::uint64 no_clock::phase_ticks ( void ) const
+{
+  return phase().remainder;
+}
+
+inline sc_dt::uint64 no_clock::delay_ticks ( sc_dt::uint64 remainder, sc_dt::uint64 offset ) const
+{
+  return ( remainder <= offset ) ? ( offset - remainder ) : ( m_period_ticks + offset - remainder );
+}
+
+inline sc_dt::uint64 no_clock::delay_ticks ( sc_dt::uint64 offset ) const
+{
+  return delay_ticks(phase_ticks(),offset);
+}
+
+// Explicit shift bypasses the memoized phase unless it matches m_tSHIFT
+inline sc_dt::uint64 no_clock::phase_ticks ( sc_dt::uint64 shift ) const
+{
+  if (shift == m_shift_ticks) return phase_ticks();
+  return ( sc_core::sc_time_stamp().value() + shift ) % m_period_ticks;
+}
+
+// Delay from remainder to the next edge of kind (0 allowed only if inclusive)
+inline sc_dt::uint64 no_clock::edge_delay_ticks ( edge_kind kind, sc_dt::uint64 remainder, bool inclusive ) const
+{
+  sc_dt::uint64 tDELAY = 0;
+  switch (kind) {
+    case POSEDGE: tDELAY = delay_ticks(remainder,m_posedge_ticks); break;
+    case NEGEDGE: tDELAY = delay_ticks(remainder,m_negedge_ticks); break;
+    case SAMPLE:  tDELAY = delay_ticks(remainder,m_sample_ticks);  break;
+    case SETEDGE: tDELAY = delay_ticks(remainder,m_setedge_ticks); break;
+    case ANYEDGE: {
+      sc_dt::uint64 tPOS = delay_ticks(remainder,m_posedge_ticks);
+      sc_dt::uint64 tNEG = delay_ticks(remainder,m_negedge_ticks);
+      if (not inclusive) {
+        if (0 == tPOS) tPOS = m_period_ticks;
+        if (0 == tNEG) tNEG = m_period_ticks;
+      }//endif
+      tDELAY = (tNEG < tPOS) ? tNEG : tPOS;
+      break;
+    }
+  }//endswitch
+  if (0 == tDELAY and not inclusive) tDELAY = m_period_ticks;
+  return tDELAY;
+}
+
+// Same measured from sc_time_stamp() itself: the time base of the compatibility
+// events (and of no_clock_scheduler), which one initiator's shift must not move
+inline sc_dt::uint64 no_clock::event_delay_ticks ( edge_kind kind, Clock_count_t cycles, bool inclusive ) const
+{
+  if (m_irregular) return exact_delay_ticks(kind, sc_core::sc_time_stamp().value(), cycles, inclusive);
+  return cycles*m_period_ticks + edge_delay_ticks(kind, phase_ticks(0), inclusive);
+}
+
+inline sc_core::sc_time no_clock::delay( sc_core::sc_time tPERIOD, sc_core::sc_time tOFFSET, sc_core::sc_time tSHIFT) const
+{
+  return ::delay(tPERIOD,tOFFSET,tSHIFT);
+}
+
+inline Clock_count_t no_clock::clocks( sc_core::sc_time tPERIOD, sc_core::sc_time tZERO, sc_core::sc_time tSHIFT) const
+{
+  return ::clocks(tPERIOD,tZERO,tSHIFT);
 }
 
 //------------------------------------------------------------------------------
 // Accessors
 //------------------------------------------------------------------------------
 inline const char*      no_clock::name      ( void ) const { return m_clock_name; }
-inline sc_core::sc_time no_clock::period    ( Clock_count_t cycles ) const { return cycles*m_tPERIOD; }
+inline sc_core::sc_time no_clock::period    ( Clock_count_t cycles ) const { return sc_core::sc_time::from_value(cycles*m_period_ticks); }
 inline double           no_clock::duty      ( void ) const { return m_duty; }
 inline double           no_clock::frequency ( void ) const { return sc_core::sc_time(1,sc_core::SC_SEC)/m_tPERIOD; }
 
@@ -302,120 +866,398 @@ inline double           no_clock::frequency ( void ) const { return sc_core::sc_
 //------------------------------------------------------------------------------
 inline Clock_count_t     no_clock::cycles ( void ) const // Number of clock cycles since start
 {
-  return m_base_count + clocks(m_tPERIOD,m_frequency_set,m_tSHIFT);
+  return phase().cycles;
+}
+
+inline Clock_count_t     no_clock::cycles ( sc_core::sc_time t ) const // Number of clock cycles at time t
+{
+  const sc_dt::uint64 t_ticks = t.value(); // absolute (m_tSHIFT not applied)
+  if (m_root != nullptr) return derived_count(m_root->cycles(t));
+  if (t_ticks >= m_frequency_set.value()) {
+    if (m_gated) return m_base_count;
+    if (m_irregular) return exact_cycles(t_ticks);
+    return m_base_count + ( t_ticks - m_frequency_set.value() ) / m_period_ticks;
+  }//endif
+  // Before the last frequency change
+  const segment_t& segment(find_segment(t_ticks));
+  if (t_ticks < segment.time and not m_history_trimmed) return 0; // before construction (or reset)
+  if (t_ticks <= segment.time or segment.period == 0) return segment.base_count; // period 0: gated
+  if (segment.den != 1) return segment_cycles(segment,t_ticks);
+  return segment.base_count + ( t_ticks - segment.time ) / segment.period;
+}
+
+//------------------------------------------------------------------------------
+// Snapshot (any thread)
+//------------------------------------------------------------------------------
+inline no_clock::snapshot_t no_clock::snapshot ( void ) const
+{
+  snapshot_t result;
+  unsigned before, after;
+  do {
+    before = m_seq.load(std::memory_order_acquire);
+    result.period        = m_snap[SNAP_PERIOD].load(std::memory_order_relaxed);
+    result.posedge       = m_snap[SNAP_POSEDGE].load(std::memory_order_relaxed);
+    result.negedge       = m_snap[SNAP_NEGEDGE].load(std::memory_order_relaxed);
+    result.sample        = m_snap[SNAP_SAMPLE].load(std::memory_order_relaxed);
+    result.setedge       = m_snap[SNAP_SETEDGE].load(std::memory_order_relaxed);
+    result.count_period  = m_snap[SNAP_COUNT_PERIOD].load(std::memory_order_relaxed);
+    result.frequency_set = m_snap[SNAP_FREQUENCY_SET].load(std::memory_order_relaxed);
+    result.base_count    = m_snap[SNAP_BASE_COUNT].load(std::memory_order_relaxed);
+    result.mul           = m_snap[SNAP_MUL].load(std::memory_order_relaxed);
+    result.div           = m_snap[SNAP_DIV].load(std::memory_order_relaxed);
+    result.freq_count    = m_snap[SNAP_FREQ_COUNT].load(std::memory_order_relaxed);
+    result.gated         = m_snap[SNAP_GATED].load(std::memory_order_relaxed) != 0;
+    result.period_num    = m_snap[SNAP_PERIOD_NUM].load(std::memory_order_relaxed);
+    result.period_den    = m_snap[SNAP_PERIOD_DEN].load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    after = m_seq.load(std::memory_order_relaxed);
+  } while (before != after or (before & 1U) != 0U);
+  return result;
+}
+
+inline Clock_count_t no_clock::snapshot_t::cycles ( sc_dt::uint64 t ) const
+{
+  if (period_den != 1) return exact_cycles(t); // rational clocks are never derived
+  const Clock_count_t root_cycles = base_count
+    + ( t > frequency_set and not gated ? ( t - frequency_set ) / count_period : 0 );
+  return ( root_cycles / div ) * mul + ( root_cycles % div ) * mul / div; // root_cycles * mul / div without overflow
+}
+
+inline sc_dt::uint64 no_clock::snapshot_t::until_edge ( edge_kind kind, sc_dt::uint64 t, Clock_count_t cycles ) const
+{
+  if (period_den != 1) return exact_until_edge(kind,t,cycles);
+  const sc_dt::uint64 remainder = t % period;
+  const sc_dt::uint64 tPOS = ( remainder <= posedge ) ? ( posedge - remainder ) : ( period + posedge - remainder );
+  const sc_dt::uint64 tNEG = ( remainder <= negedge ) ? ( negedge - remainder ) : ( period + negedge - remainder );
+  sc_dt::uint64 tDELAY = 0;
+  switch (kind) {
+    case POSEDGE: tDELAY = tPOS; break;
+    case NEGEDGE: tDELAY = tNEG; break;
+    case ANYEDGE: tDELAY = ( tNEG < tPOS ) ? tNEG : tPOS; break;
+    case SAMPLE:  tDELAY = ( remainder <= sample  ) ? ( sample  - remainder ) : ( period + sample  - remainder ); break;
+    case SETEDGE: tDELAY = ( remainder <= setedge ) ? ( setedge - remainder ) : ( period + setedge - remainder ); break;
+  }//endswitch
+  return cycles*period + tDELAY;
+}
+
+inline bool no_clock::snapshot_t::read ( sc_dt::uint64 t ) const
+{
+  return until_edge(NEGEDGE,t) < until_edge(POSEDGE,t);
 }
 
 // Calculate the delay till... (use for temporal offset)
 inline sc_core::sc_time  no_clock::until_posedge ( Clock_count_t cycles ) const
 {
-  return cycles*m_tPERIOD+delay(m_tPERIOD,m_tPOSEDGE,m_tSHIFT);
+  NO_CLOCK_STAT(STAT_UNTIL);
+  if (m_irregular) return sc_core::sc_time::from_value(exact_delay_ticks(POSEDGE,cycles,true));
+  return sc_core::sc_time::from_value( cycles*m_period_ticks + delay_ticks(m_posedge_ticks) );
 }
 
 inline sc_core::sc_time  no_clock::until_negedge ( Clock_count_t cycles ) const
 {
-  return cycles*m_tPERIOD+delay(m_tPERIOD,m_tNEGEDGE,m_tSHIFT);
+  NO_CLOCK_STAT(STAT_UNTIL);
+  if (m_irregular) return sc_core::sc_time::from_value(exact_delay_ticks(NEGEDGE,cycles,true));
+  return sc_core::sc_time::from_value( cycles*m_period_ticks + delay_ticks(m_negedge_ticks) );
 }
 
 inline sc_core::sc_time  no_clock::until_anyedge ( Clock_count_t cycles ) const
 {
-  return cycles*m_tPERIOD+(true==read()?until_negedge():until_posedge());
+  NO_CLOCK_STAT(STAT_UNTIL);
+  if (m_irregular) return sc_core::sc_time::from_value(exact_delay_ticks(ANYEDGE,cycles,true));
+  const sc_dt::uint64 remainder = phase_ticks();
+  const sc_dt::uint64 tPOS = delay_ticks(remainder,m_posedge_ticks);
+  const sc_dt::uint64 tNEG = delay_ticks(remainder,m_negedge_ticks);
+  return sc_core::sc_time::from_value( cycles*m_period_ticks + ( tNEG < tPOS ? tNEG : tPOS ) );
 }
 
 inline sc_core::sc_time  no_clock::until_sample  ( Clock_count_t cycles ) const
 {
-  return cycles*m_tPERIOD+delay(m_tPERIOD,m_tSAMPLE,m_tSHIFT);
+  NO_CLOCK_STAT(STAT_UNTIL);
+  if (m_irregular) return sc_core::sc_time::from_value(exact_delay_ticks(SAMPLE,cycles,true));
+  return sc_core::sc_time::from_value( cycles*m_period_ticks + delay_ticks(m_sample_ticks) );
 }
 
 inline sc_core::sc_time  no_clock::until_setedge ( Clock_count_t cycles ) const
 {
-  return cycles*m_tPERIOD+delay(m_tPERIOD,m_tSETEDGE,m_tSHIFT);
+  NO_CLOCK_STAT(STAT_UNTIL);
+  if (m_irregular) return sc_core::sc_time::from_value(exact_delay_ticks(SETEDGE,cycles,true));
+  return sc_core::sc_time::from_value( cycles*m_period_ticks + delay_ticks(m_setedge_ticks) );
 }
 
 // Calculate the delay till next... (use for temporal offset) - never returns 0
 inline sc_core::sc_time  no_clock::next_posedge ( Clock_count_t cycles ) const
 {
-  sc_core::sc_time t(delay(m_tPERIOD,m_tPOSEDGE,m_tSHIFT));
-  return (cycles + (sc_core::SC_ZERO_TIME == t?1:0)) * m_tPERIOD + t;
+  NO_CLOCK_STAT(STAT_NEXT);
+  if (m_irregular) return sc_core::sc_time::from_value(exact_delay_ticks(POSEDGE,cycles,false));
+  const sc_dt::uint64 t = delay_ticks(m_posedge_ticks);
+  return sc_core::sc_time::from_value( (cycles + (0 == t?1:0)) * m_period_ticks + t );
 }
 
 inline sc_core::sc_time  no_clock::next_negedge ( Clock_count_t cycles ) const
 {
-  sc_core::sc_time t(delay(m_tPERIOD,m_tNEGEDGE,m_tSHIFT));
-  return (cycles + (sc_core::SC_ZERO_TIME == t?1:0)) * m_tPERIOD + t;
+  NO_CLOCK_STAT(STAT_NEXT);
+  if (m_irregular) return sc_core::sc_time::from_value(exact_delay_ticks(NEGEDGE,cycles,false));
+  const sc_dt::uint64 t = delay_ticks(m_negedge_ticks);
+  return sc_core::sc_time::from_value( (cycles + (0 == t?1:0)) * m_period_ticks + t );
 }
 
 inline sc_core::sc_time  no_clock::next_anyedge ( Clock_count_t cycles ) const
 {
-  return cycles*m_tPERIOD+(true==read()?next_negedge():next_posedge());
+  NO_CLOCK_STAT(STAT_NEXT);
+  if (m_irregular) return sc_core::sc_time::from_value(exact_delay_ticks(ANYEDGE,cycles,false));
+  const sc_dt::uint64 remainder = phase_ticks();
+  sc_dt::uint64 tPOS = delay_ticks(remainder,m_posedge_ticks);
+  sc_dt::uint64 tNEG = delay_ticks(remainder,m_negedge_ticks);
+  if (0 == tPOS) tPOS = m_period_ticks;
+  if (0 == tNEG) tNEG = m_period_ticks;
+  return sc_core::sc_time::from_value( cycles*m_period_ticks + ( tNEG < tPOS ? tNEG : tPOS ) );
 }
 
 inline sc_core::sc_time  no_clock::next_sample  ( Clock_count_t cycles ) const
 {
-  sc_core::sc_time t(delay(m_tPERIOD,m_tSAMPLE,m_tSHIFT));
-  return (cycles + (sc_core::SC_ZERO_TIME == t?1:0)) * m_tPERIOD + t;
+  NO_CLOCK_STAT(STAT_NEXT);
+  if (m_irregular) return sc_core::sc_time::from_value(exact_delay_ticks(SAMPLE,cycles,false));
+  const sc_dt::uint64 t = delay_ticks(m_sample_ticks);
+  return sc_core::sc_time::from_value( (cycles + (0 == t?1:0)) * m_period_ticks + t );
 }
 
 inline sc_core::sc_time  no_clock::next_setedge ( Clock_count_t cycles ) const
 {
-  sc_core::sc_time t(delay(m_tPERIOD,m_tSETEDGE,m_tSHIFT));
-  return (cycles + (sc_core::SC_ZERO_TIME == t?1:0)) * m_tPERIOD + t;
+  NO_CLOCK_STAT(STAT_NEXT);
+  if (m_irregular) return sc_core::sc_time::from_value(exact_delay_ticks(SETEDGE,cycles,false));
+  const sc_dt::uint64 t = delay_ticks(m_setedge_ticks);
+  return sc_core::sc_time::from_value( (cycles + (0 == t?1:0)) * m_period_ticks + t );
 }
 
 // Wait only if really necessary (for use in SC_THREAD) -- may be a NOP if cycles == 0
+inline void no_clock::suspend ( sc_dt::uint64 ticks, edge_kind kind, Clock_count_t cycles )
+{
+  NO_CLOCK_STAT(STAT_WAIT);
+  if (m_gated) {
+    wait_ungated(kind,cycles); // duration unknown until ungate()
+  } else if (0 != ticks) {
+    NO_CLOCK_STAT(STAT_SUSPEND);
+    NO_CLOCK_WAIT_STAT(ticks);
+    sc_core::wait(sc_core::sc_time::from_value(ticks));
+    if (m_gated) wait_ungated(kind,0); // gated while asleep
+  } else {
+    NO_CLOCK_STAT(STAT_ZERO_WAIT);
+    NO_CLOCK_WAIT_STAT(0);
+  }//endif
+}
+
 inline void no_clock::wait_posedge ( Clock_count_t cycles )
 {
-  sc_core::sc_time t(until_posedge(cycles));
-  if (sc_core::SC_ZERO_TIME != t) wait(t);
+  if (m_irregular) return suspend(exact_delay_ticks(POSEDGE,cycles,true),POSEDGE,cycles);
+  suspend( cycles*m_period_ticks + delay_ticks(m_posedge_ticks), POSEDGE, cycles );
 }
 
 inline void no_clock::wait_negedge ( Clock_count_t cycles )
 {
-  sc_core::sc_time t(until_negedge(cycles));
-  if (sc_core::SC_ZERO_TIME != t) wait(t);
+  if (m_irregular) return suspend(exact_delay_ticks(NEGEDGE,cycles,true),NEGEDGE,cycles);
+  suspend( cycles*m_period_ticks + delay_ticks(m_negedge_ticks), NEGEDGE, cycles );
 }
 
 inline void no_clock::wait_anyedge ( Clock_count_t cycles )
 {
-  sc_core::sc_time t(until_anyedge(cycles));
-  if (sc_core::SC_ZERO_TIME != t) wait(t);
+  if (m_irregular) return suspend(exact_delay_ticks(ANYEDGE,cycles,true),ANYEDGE,cycles);
+  suspend( cycles*m_period_ticks + edge_delay_ticks(ANYEDGE,phase_ticks(),true), ANYEDGE, cycles );
 }
 
 inline void no_clock::wait_sample  ( Clock_count_t cycles )
 {
-  sc_core::sc_time t(until_sample(cycles));
-  if (sc_core::SC_ZERO_TIME != t) wait(t);
+  if (m_irregular) return suspend(exact_delay_ticks(SAMPLE,cycles,true),SAMPLE,cycles);
+  suspend( cycles*m_period_ticks + delay_ticks(m_sample_ticks), SAMPLE, cycles );
 }
 
 inline void no_clock::wait_setedge ( Clock_count_t cycles )
 {
-  sc_core::sc_time t(until_setedge(cycles));
-  if (sc_core::SC_ZERO_TIME != t) wait(t);
+  if (m_irregular) return suspend(exact_delay_ticks(SETEDGE,cycles,true),SETEDGE,cycles);
+  suspend( cycles*m_period_ticks + delay_ticks(m_setedge_ticks), SETEDGE, cycles );
+}
+
+inline void no_clock::wait_edge    ( edge_kind kind, Clock_count_t cycles )
+{
+  if (m_irregular) return suspend(exact_delay_ticks(kind,cycles,true),kind,cycles);
+  suspend( cycles*m_period_ticks + edge_delay_ticks(kind,phase_ticks(),true), kind, cycles );
 }
 
 // Are we there? (use in SC_METHOD)
 inline bool no_clock::at_posedge_time ( void ) const
 {
-  return until_posedge(0) == sc_core::SC_ZERO_TIME;
+  NO_CLOCK_STAT(STAT_AT);
+  if (m_irregular) return not m_gated and 0 == exact_delay_ticks(POSEDGE,0,true);
+  return not m_gated and phase_ticks() == m_posedge_ticks;
 }
 
 inline bool no_clock::at_negedge_time ( void ) const
 {
-  return until_negedge(0) == sc_core::SC_ZERO_TIME;
+  NO_CLOCK_STAT(STAT_AT);
+  if (m_irregular) return not m_gated and 0 == exact_delay_ticks(NEGEDGE,0,true);
+  return not m_gated and phase_ticks() == m_negedge_ticks;
 }
 
 inline bool no_clock::at_anyedge_time ( void ) const
 {
-  return until_anyedge(0) == sc_core::SC_ZERO_TIME;
+  NO_CLOCK_STAT(STAT_AT);
+  if (m_irregular) return not m_gated and 0 == exact_delay_ticks(ANYEDGE,0,true);
+  const sc_dt::uint64 remainder = phase_ticks();
+  return not m_gated and ( remainder == m_posedge_ticks or remainder == m_negedge_ticks );
 }
 
 inline bool no_clock::at_sample_time  ( void ) const
 {
-  return until_sample(0) == sc_core::SC_ZERO_TIME;
+  NO_CLOCK_STAT(STAT_AT);
+  if (m_irregular) return not m_gated and 0 == exact_delay_ticks(SAMPLE,0,true);
+  return not m_gated and phase_ticks() == m_sample_ticks;
 }
 
 inline bool no_clock::at_setedge_time ( void ) const
 {
-  return until_sample(0) == sc_core::SC_ZERO_TIME;
+  NO_CLOCK_STAT(STAT_AT);
+  if (m_irregular) return not m_gated and 0 == exact_delay_ticks(SETEDGE,0,true);
+  return not m_gated and phase_ticks() == m_setedge_ticks;
+}
+
+inline sc_core::sc_time  no_clock::until_edge ( edge_kind kind, Clock_count_t cycles ) const
+{
+  switch (kind) {
+    case POSEDGE: return until_posedge(cycles);
+    case NEGEDGE: return until_negedge(cycles);
+    case ANYEDGE: return until_anyedge(cycles);
+    case SAMPLE:  return until_sample(cycles);
+    case SETEDGE: return until_setedge(cycles);
+  }//endswitch
+  return sc_core::SC_ZERO_TIME;
+}
+
+inline sc_core::sc_time  no_clock::next_edge ( edge_kind kind, Clock_count_t cycles ) const
+{
+  switch (kind) {
+    case POSEDGE: return next_posedge(cycles);
+    case NEGEDGE: return next_negedge(cycles);
+    case ANYEDGE: return next_anyedge(cycles);
+    case SAMPLE:  return next_sample(cycles);
+    case SETEDGE: return next_setedge(cycles);
+  }//endswitch
+  return sc_core::SC_ZERO_TIME;
+}
+
+// Earliest edge among several clocks
+inline no_clock::any_edge_t no_clock::until_any ( no_clock* const* clocks, size_t n, edge_kind kind, Clock_count_t cycles )
+{
+  any_edge_t result = { sc_core::SC_ZERO_TIME, nullptr };
+  for (size_t i = 0; i != n; ++i) {
+    if (clocks[i]->gated()) continue;
+    const sc_core::sc_time t(clocks[i]->until_edge(kind,cycles));
+    if (result.clock == nullptr or t < result.delay) {
+      result.delay = t;
+      result.clock = clocks[i];
+    }//endif
+  }//endfor
+  return result;
+}
+
+inline no_clock::any_edge_t no_clock::next_any ( no_clock* const* clocks, size_t n, edge_kind kind, Clock_count_t cycles )
+{
+  any_edge_t result = { sc_core::SC_ZERO_TIME, nullptr };
+  for (size_t i = 0; i != n; ++i) {
+    if (clocks[i]->gated()) continue;
+    const sc_core::sc_time t(clocks[i]->next_edge(kind,cycles));
+    if (result.clock == nullptr or t < result.delay) {
+      result.delay = t;
+      result.clock = clocks[i];
+    }//endif
+  }//endfor
+  return result;
+}
+
+inline no_clock::any_edge_t no_clock::until_any ( std::initializer_list<no_clock*> clocks, edge_kind kind, Clock_count_t cycles )
+{
+  return until_any(clocks.begin(),clocks.size(),kind,cycles);
+}
+
+inline no_clock::any_edge_t no_clock::next_any ( std::initializer_list<no_clock*> clocks, edge_kind kind, Clock_count_t cycles )
+{
+  return next_any(clocks.begin(),clocks.size(),kind,cycles);
+}
+
+// Gated clocks are skipped, but their ungate() also wakes the caller to recompute
+// (it may come before the earliest edge, and is the only wakeup if all are gated)
+inline no_clock* no_clock::wait_any ( no_clock* const* clocks, size_t n, edge_kind kind )
+{
+  for (;;) {
+    const any_edge_t first(until_any(clocks,n,kind));
+    sc_core::sc_event_or_list ungated;
+    bool gated = false;
+    for (size_t i = 0; i != n; ++i) {
+      if (not clocks[i]->gated()) continue;
+      ungated |= clocks[i]->m_ungate_event;
+      gated = true;
+    }//endfor
+    if (not gated or (first.clock != nullptr and first.delay == sc_core::SC_ZERO_TIME)) {
+      if (first.clock != nullptr) first.clock->suspend(first.delay.value(),kind,0);
+      return first.clock; // nullptr only for an empty list
+    }//endif
+    if (first.clock == nullptr) sc_core::wait(ungated);
+    else sc_core::wait(first.delay,ungated);
+  }//endfor
+}
+
+inline no_clock* no_clock::wait_any ( std::initializer_list<no_clock*> clocks, edge_kind kind )
+{
+  return wait_any(clocks.begin(),clocks.size(),kind);
+}
+
+// Batch form of until_* (ANYEDGE has no constant stride and is computed per element)
+inline void no_clock::edge_times ( edge_kind kind, sc_dt::uint64* out, size_t n ) const
+{
+  if (ANYEDGE == kind) {
+    for (size_t k = 0; k != n; ++k) out[k] = until_anyedge(k).value();
+    return;
+  }//endif
+  if (m_irregular) {
+    for (size_t k = 0; k != n; ++k) out[k] = until_edge(kind,k).value();
+    return;
+  }//endif
+  const sc_dt::uint64 first  = until_edge(kind).value();
+  const sc_dt::uint64 stride = m_period_ticks;
+  for (size_t k = 0; k != n; ++k) out[k] = first + k*stride;
+}
+
+inline void no_clock::edge_times ( edge_kind kind, sc_core::sc_time* out, size_t n ) const
+{
+  if (ANYEDGE == kind) {
+    for (size_t k = 0; k != n; ++k) out[k] = until_anyedge(k);
+    return;
+  }//endif
+  if (m_irregular) {
+    for (size_t k = 0; k != n; ++k) out[k] = until_edge(kind,k);
+    return;
+  }//endif
+  const sc_dt::uint64 first  = until_edge(kind).value();
+  const sc_dt::uint64 stride = m_period_ticks;
+  for (size_t k = 0; k != n; ++k) out[k] = sc_core::sc_time::from_value(first + k*stride);
+}
+
+inline sc_core::sc_time  no_clock::until_edge ( edge_kind kind, Clock_count_t cycles, const sc_core::sc_time& tSHIFT ) const
+{
+  NO_CLOCK_STAT(STAT_UNTIL);
+  if (m_irregular) {
+    return sc_core::sc_time::from_value(exact_delay_ticks(kind,sc_core::sc_time_stamp().value()+tSHIFT.value(),cycles,true));
+  }//endif
+  return sc_core::sc_time::from_value
+    ( cycles*m_period_ticks + edge_delay_ticks(kind,phase_ticks(tSHIFT.value()),true) );
+}
+
+inline sc_core::sc_time  no_clock::next_edge ( edge_kind kind, Clock_count_t cycles, const sc_core::sc_time& tSHIFT ) const
+{
+  NO_CLOCK_STAT(STAT_NEXT);
+  if (m_irregular) {
+    return sc_core::sc_time::from_value(exact_delay_ticks(kind,sc_core::sc_time_stamp().value()+tSHIFT.value(),cycles,false));
+  }//endif
+  return sc_core::sc_time::from_value
+    ( cycles*m_period_ticks + edge_delay_ticks(kind,phase_ticks(tSHIFT.value()),false) );
 }
 
 // For compatibility if you really have/want to
@@ -426,42 +1268,33 @@ inline sc_core::sc_event& no_clock::default_event       ( size_t events )
 
 inline sc_core::sc_event& no_clock::posedge_event       ( size_t events )
 {
-  wait_posedge(events);
-  m_posedge_event.notify(sc_core::SC_ZERO_TIME);
-  return m_posedge_event;
+  return edge_event(POSEDGE,events);
 }
 
 inline sc_core::sc_event& no_clock::negedge_event       ( size_t events )
 {
-  wait_negedge(events);
-  m_negedge_event.notify(sc_core::SC_ZERO_TIME);
-  return m_negedge_event;
+  return edge_event(NEGEDGE,events);
 }
 
 inline sc_core::sc_event& no_clock::sample_event        ( size_t events )
 {
-  wait_sample(events);
-  m_sample_event.notify(sc_core::SC_ZERO_TIME);
-  return m_sample_event;
+  return edge_event(SAMPLE,events);
 }
 
 inline sc_core::sc_event& no_clock::setedge_event       ( size_t events )
 {
-  wait_setedge(events);
-  m_setedge_event.notify(sc_core::SC_ZERO_TIME);
-  return m_setedge_event;
+  return edge_event(SETEDGE,events);
 }
 
 inline sc_core::sc_event& no_clock::value_changed_event ( size_t events )
 {
-  wait_anyedge(events);
-  m_anyedge_event.notify(sc_core::SC_ZERO_TIME);
-  return m_anyedge_event;
+  return edge_event(ANYEDGE,events);
 }
 
 inline bool      no_clock::read                ( void ) const
 {
-  return until_negedge()<until_posedge();
+  NO_CLOCK_STAT(STAT_READ);
+  return phase().level;
 }
 
 #endif
@@ -0,0 +1,233 @@
+#ifndef NONCLOCK_BANK_HPP
+#define NONCLOCK_BANK_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+// $License: Apache 2.0 $
+//
+// This file is licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Description: Struct-of-arrays table for very large numbers of clocks.
+//
+// Each clock is one row of a few parallel tick arrays (period, edge offsets,
+// counting base) instead of a full no_clock with its sc_object base and five
+// sc_events. Clocks are addressed through the lightweight no_clock_bank::clock
+// handle (a pointer and an index). The compatibility events are only created
+// when first asked for: a companion no_clock is then made for that clock and
+// kept in step with it, so the shared no_clock_scheduler drives it as usual.
+//
+// Example:
+//   no_clock_bank bank("cores", 4096);
+//   for (...) bank.add(name, sc_time(1,SC_NS));
+//   no_clock_bank::clock clk(bank[42]);
+//   clk.wait_posedge();
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "no_clock.hpp"
+#include <deque>
+#include <string>
+#include <vector>
+
+class no_clock_bank
+: public sc_core::sc_object
+{
+public:
+  typedef std::size_t         index_t;
+  typedef no_clock::edge_kind edge_kind;
+  class clock; // handle
+
+  explicit no_clock_bank ( const char* instance, size_t reserve = 0 );
+  virtual ~no_clock_bank ( void );
+
+  // Add a clock (same arguments and rules as the original no_clock constructor)
+  index_t add
+  ( const char*             clock_name
+  , const sc_core::sc_time& tPERIOD
+  , double                  duty     = 0.5
+  , const sc_core::sc_time& tOFFSET  = sc_core::SC_ZERO_TIME
+  , bool                    positive = true
+  );
+  size_t      size       ( void ) const { return m_period.size(); }
+  clock       operator[] ( index_t i );
+  const char* clock_name ( index_t i ) const { return m_name[i].c_str(); }
+
+  // Per clock (see no_clock for the meaning of each)
+  void               set_period_time ( index_t i, const sc_core::sc_time& tPERIOD ); // edge offsets scale with it
+  void               set_frequency   ( index_t i, double frequency );
+  sc_core::sc_time   period          ( index_t i ) const { return sc_core::sc_time::from_value(m_period[i]); }
+  Clock_count_t      cycles          ( index_t i ) const;
+  sc_core::sc_time   until_edge      ( index_t i, edge_kind kind, Clock_count_t cycles = 0U ) const;
+  sc_core::sc_time   next_edge       ( index_t i, edge_kind kind, Clock_count_t cycles = 0U ) const;
+  bool               at_edge_time    ( index_t i, edge_kind kind ) const;
+  bool               read            ( index_t i ) const;
+  void               wait_edge       ( index_t i, edge_kind kind, Clock_count_t cycles = 0U );
+  sc_core::sc_event& edge_event      ( index_t i, edge_kind kind, size_t events = 0 ); // creates the companion
+
+  // Whole bank at once: one time stamp, then a linear pass over the arrays
+  void until_edge ( edge_kind kind, sc_dt::uint64* out, Clock_count_t cycles = 0U ) const; // out[size()] ticks
+  void cycles     ( Clock_count_t* out ) const; // out[size()]
+
+private:
+  sc_dt::uint64 delay_ticks ( index_t i, edge_kind kind, sc_dt::uint64 now, bool inclusive ) const;
+  void          sync        ( index_t i ); // copy row i to its companion
+  // Don't allow copying
+  no_clock_bank ( const no_clock_bank& ) = delete; // Copy constructor
+  no_clock_bank& operator= ( const no_clock_bank& ) = delete; // Assignment
+  // Struct of arrays (ticks), one entry per clock
+  std::vector<sc_dt::uint64> m_period;
+  std::vector<sc_dt::uint64> m_posedge;  // normalized to [0,period)
+  std::vector<sc_dt::uint64> m_negedge;
+  std::vector<sc_dt::uint64> m_sample;
+  std::vector<sc_dt::uint64> m_setedge;
+  std::vector<sc_dt::uint64> m_frequency_set; // when period was last changed
+  std::vector<Clock_count_t> m_base_count;    // cycles up to last frequency change
+  std::deque<std::string>    m_name;          // stable (companions keep pointers)
+  std::vector<no_clock*>     m_companion;     // compatibility events (nullptr until first use)
+};
+
+//------------------------------------------------------------------------------
+// Lightweight handle to one clock of a bank (cheap to copy, not a channel)
+class no_clock_bank::clock
+{
+public:
+  clock ( no_clock_bank& bank, index_t index ) : m_bank(&bank), m_index(index) { }
+
+  index_t          index      ( void ) const { return m_index; }
+  const char*      clock_name ( void ) const { return m_bank->clock_name(m_index); }
+  sc_core::sc_time period     ( void ) const { return m_bank->period(m_index); }
+  Clock_count_t    cycles     ( void ) const { return m_bank->cycles(m_index); }
+  void set_period_time ( const sc_core::sc_time& tPERIOD ) { m_bank->set_period_time(m_index,tPERIOD); }
+  void set_frequency   ( double frequency )                { m_bank->set_frequency(m_index,frequency); }
+  // Calculate the delay till... (may return SC_ZERO_TIME if already on the edge)
+  sc_core::sc_time until_posedge ( Clock_count_t cycles = 0U ) const { return m_bank->until_edge(m_index,no_clock::POSEDGE,cycles); }
+  sc_core::sc_time until_negedge ( Clock_count_t cycles = 0U ) const { return m_bank->until_edge(m_index,no_clock::NEGEDGE,cycles); }
+  sc_core::sc_time until_anyedge ( Clock_count_t cycles = 0U ) const { return m_bank->until_edge(m_index,no_clock::ANYEDGE,cycles); }
+  sc_core::sc_time until_sample  ( Clock_count_t cycles = 0U ) const { return m_bank->until_edge(m_index,no_clock::SAMPLE,cycles);  }
+  sc_core::sc_time until_setedge ( Clock_count_t cycles = 0U ) const { return m_bank->until_edge(m_index,no_clock::SETEDGE,cycles); }
+  // Calculate the delay till next... (never returns SC_ZERO_TIME)
+  sc_core::sc_time next_posedge  ( Clock_count_t cycles = 0U ) const { return m_bank->next_edge(m_index,no_clock::POSEDGE,cycles); }
+  sc_core::sc_time next_negedge  ( Clock_count_t cycles = 0U ) const { return m_bank->next_edge(m_index,no_clock::NEGEDGE,cycles); }
+  sc_core::sc_time next_anyedge  ( Clock_count_t cycles = 0U ) const { return m_bank->next_edge(m_index,no_clock::ANYEDGE,cycles); }
+  sc_core::sc_time next_sample   ( Clock_count_t cycles = 0U ) const { return m_bank->next_edge(m_index,no_clock::SAMPLE,cycles);  }
+  sc_core::sc_time next_setedge  ( Clock_count_t cycles = 0U ) const { return m_bank->next_edge(m_index,no_clock::SETEDGE,cycles); }
+  // Wait only if really necessary (for use in SC_THREAD)
+  void wait         ( Clock_count_t cycles = 0U ) { m_bank->wait_edge(m_index,no_clock::POSEDGE,cycles); }
+  void wait_posedge ( Clock_count_t cycles = 0U ) { m_bank->wait_edge(m_index,no_clock::POSEDGE,cycles); }
+  void wait_negedge ( Clock_count_t cycles = 0U ) { m_bank->wait_edge(m_index,no_clock::NEGEDGE,cycles); }
+  void wait_anyedge ( Clock_count_t cycles = 0U ) { m_bank->wait_edge(m_index,no_clock::ANYEDGE,cycles); }
+  void wait_sample  ( Clock_count_t cycles = 0U ) { m_bank->wait_edge(m_index,no_clock::SAMPLE,cycles);  }
+  void wait_setedge ( Clock_count_t cycles = 0U ) { m_bank->wait_edge(m_index,no_clock::SETEDGE,cycles); }
+  // Are we there? (use in SC_METHOD)
+  bool at_posedge_time ( void ) const { return m_bank->at_edge_time(m_index,no_clock::POSEDGE); }
+  bool posedge         ( void ) const { return at_posedge_time(); }
+  bool at_negedge_time ( void ) const { return m_bank->at_edge_time(m_index,no_clock::NEGEDGE); }
+  bool negedge         ( void ) const { return at_negedge_time(); }
+  bool at_anyedge_time ( void ) const { return m_bank->at_edge_time(m_index,no_clock::ANYEDGE); }
+  bool event           ( void ) const { return at_anyedge_time(); }
+  bool at_sample_time  ( void ) const { return m_bank->at_edge_time(m_index,no_clock::SAMPLE);  }
+  bool at_setedge_time ( void ) const { return m_bank->at_edge_time(m_index,no_clock::SETEDGE); }
+  bool read            ( void ) const { return m_bank->read(m_index); }
+  // For compatibility (first call creates the events for this clock)
+  sc_core::sc_event& default_event       ( size_t events = 0 ) { return value_changed_event(events); }
+  sc_core::sc_event& posedge_event       ( size_t events = 0 ) { return m_bank->edge_event(m_index,no_clock::POSEDGE,events); }
+  sc_core::sc_event& negedge_event       ( size_t events = 0 ) { return m_bank->edge_event(m_index,no_clock::NEGEDGE,events); }
+  sc_core::sc_event& sample_event        ( size_t events = 0 ) { return m_bank->edge_event(m_index,no_clock::SAMPLE,events);  }
+  sc_core::sc_event& setedge_event       ( size_t events = 0 ) { return m_bank->edge_event(m_index,no_clock::SETEDGE,events); }
+  sc_core::sc_event& value_changed_event ( size_t events = 0 ) { return m_bank->edge_event(m_index,no_clock::ANYEDGE,events); }
+
+private:
+  no_clock_bank* m_bank;
+  index_t        m_index;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// For efficiency
+
+inline no_clock_bank::clock no_clock_bank::operator[] ( index_t i )
+{
+  return clock(*this,i);
+}
+
+// Delay from now to the next edge of kind (0 allowed only if inclusive)
+inline sc_dt::uint64 no_clock_bank::delay_ticks ( index_t i, edge_kind kind, sc_dt::uint64 now, bool inclusive ) const
+{
+  const sc_dt::uint64 period    = m_period[i];
+  const sc_dt::uint64 remainder = now % period;
+  sc_dt::uint64 offset = 0;
+  switch (kind) {
+    case no_clock::POSEDGE: offset = m_posedge[i]; break;
+    case no_clock::NEGEDGE: offset = m_negedge[i]; break;
+    case no_clock::SAMPLE:  offset = m_sample[i];  break;
+    case no_clock::SETEDGE: offset = m_setedge[i]; break;
+    case no_clock::ANYEDGE: {
+      const sc_dt::uint64 tPOS = delay_ticks(i,no_clock::POSEDGE,now,inclusive);
+      const sc_dt::uint64 tNEG = delay_ticks(i,no_clock::NEGEDGE,now,inclusive);
+      return (tNEG < tPOS) ? tNEG : tPOS;
+    }
+  }//endswitch
+  sc_dt::uint64 tDELAY = ( remainder <= offset ) ? ( offset - remainder ) : ( period + offset - remainder );
+  if (0 == tDELAY and not inclusive) tDELAY = period;
+  return tDELAY;
+}
+
+inline Clock_count_t no_clock_bank::cycles ( index_t i ) const
+{
+  return m_base_count[i] + ( sc_core::sc_time_stamp().value() - m_frequency_set[i] ) / m_period[i];
+}
+
+inline sc_core::sc_time no_clock_bank::until_edge ( index_t i, edge_kind kind, Clock_count_t cycles ) const
+{
+  return sc_core::sc_time::from_value
+    ( cycles*m_period[i] + delay_ticks(i,kind,sc_core::sc_time_stamp().value(),true) );
+}
+
+inline sc_core::sc_time no_clock_bank::next_edge ( index_t i, edge_kind kind, Clock_count_t cycles ) const
+{
+  return sc_core::sc_time::from_value
+    ( cycles*m_period[i] + delay_ticks(i,kind,sc_core::sc_time_stamp().value(),false) );
+}
+
+inline bool no_clock_bank::at_edge_time ( index_t i, edge_kind kind ) const
+{
+  return 0 == delay_ticks(i,kind,sc_core::sc_time_stamp().value(),true);
+}
+
+inline bool no_clock_bank::read ( index_t i ) const
+{
+  const sc_dt::uint64 now = sc_core::sc_time_stamp().value();
+  return delay_ticks(i,no_clock::NEGEDGE,now,true) < delay_ticks(i,no_clock::POSEDGE,now,true);
+}
+
+inline void no_clock_bank::wait_edge ( index_t i, edge_kind kind, Clock_count_t cycles )
+{
+  const sc_dt::uint64 t = cycles*m_period[i] + delay_ticks(i,kind,sc_core::sc_time_stamp().value(),true);
+  if (0 != t) sc_core::wait(sc_core::sc_time::from_value(t));
+}
+
+inline void no_clock_bank::until_edge ( edge_kind kind, sc_dt::uint64* out, Clock_count_t cycles ) const
+{
+  const sc_dt::uint64 now = sc_core::sc_time_stamp().value();
+  for (index_t i = 0; i != size(); ++i) out[i] = cycles*m_period[i] + delay_ticks(i,kind,now,true);
+}
+
+inline void no_clock_bank::cycles ( Clock_count_t* out ) const
+{
+  const sc_dt::uint64 now = sc_core::sc_time_stamp().value();
+  for (index_t i = 0; i != size(); ++i) out[i] = m_base_count[i] + ( now - m_frequency_set[i] ) / m_period[i];
+}
+
+#endif
+
+// TAF!
@@ -0,0 +1,103 @@
+#ifndef NONCLOCK_CORO_HPP
+#define NONCLOCK_CORO_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+// $License: Apache 2.0 $
+//
+// This file is licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Description: C++20 coroutines on no_clock edges without SC_THREAD stacks.
+//
+// A no_clock_task is a coroutine whose frame is the only per-process state;
+// no_clock_spawn() runs it from a dynamic SC_METHOD that is re-triggered with
+// next_trigger() each time the task awaits an edge (see no_clock::edge_awaitable_t).
+//
+// Example:
+//   no_clock_task bus_master ( no_clock& clk ) {
+//     for (;;) {
+//       co_await clk.posedge_awaitable();  // no-op if already on the edge
+//       ...
+//       co_await clk.sample_awaitable(2);
+//     }
+//   }
+//   no_clock_spawn(bus_master(*clk), "bus_master");
+//
+// Requires C++20 coroutine support (this header is empty without it) and, as for
+// any sc_spawn, SC_INCLUDE_DYNAMIC_PROCESSES defined before <systemc>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "no_clock.hpp"
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#include <coroutine>
+#include <exception>
+
+class no_clock_task
+{
+public:
+  struct promise_type
+  {
+    no_clock::edge_awaitable_t* waiting = nullptr; // set by edge_awaitable_t::await_suspend
+    std::exception_ptr          error;
+    no_clock_task       get_return_object   ( void ) { return no_clock_task(handle_t::from_promise(*this)); }
+    std::suspend_always initial_suspend     ( void ) noexcept { return {}; } // started by no_clock_spawn
+    std::suspend_always final_suspend       ( void ) noexcept { return {}; } // destroyed by the driver
+    void                return_void         ( void ) { }
+    void                unhandled_exception ( void ) { error = std::current_exception(); }
+  };
+  typedef std::coroutine_handle<promise_type> handle_t;
+
+  no_clock_task ( no_clock_task&& other ) noexcept : m_handle(other.m_handle) { other.m_handle = nullptr; }
+  ~no_clock_task ( void ) { if (m_handle) m_handle.destroy(); } // never spawned
+  handle_t release ( void ) { handle_t h = m_handle; m_handle = nullptr; return h; }
+
+private:
+  explicit no_clock_task ( handle_t h ) : m_handle(h) { }
+  no_clock_task ( const no_clock_task& ) = delete;
+  no_clock_task& operator= ( const no_clock_task& ) = delete;
+  handle_t m_handle;
+};
+
+// Run task from its own SC_METHOD (first step at the next evaluation, or at
+// initialization if spawned during elaboration); returns the method's handle
+inline sc_core::sc_process_handle no_clock_spawn
+( no_clock_task task, const char* name = nullptr )
+{
+  const no_clock_task::handle_t h = task.release();
+  sc_core::sc_spawn_options opts;
+  opts.spawn_method();
+  return sc_core::sc_spawn
+  ( [h]() {
+      no_clock_task::promise_type& promise(h.promise());
+      if (promise.waiting != nullptr and not promise.waiting->poll()) return; // still asleep
+      promise.waiting = nullptr;
+      h.resume(); // runs to the next co_await that must sleep (which calls next_trigger)
+      if (h.done()) {
+        const std::exception_ptr error(promise.error);
+        h.destroy();
+        if (error) std::rethrow_exception(error);
+      }//endif
+    }
+  , name ? name : sc_core::sc_gen_unique_name("no_clock_task")
+  , &opts
+  );
+}
+
+#endif
+
+#endif
+
+// TAF!
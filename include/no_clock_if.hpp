@@ -52,6 +52,11 @@ struct no_clock_if
   virtual sc_core::sc_time   next_anyedge       ( Clock_count_t cycles = 0U ) const = 0;
   virtual sc_core::sc_time   next_sample        ( Clock_count_t cycles = 0U ) const = 0;
   virtual sc_core::sc_time   next_setedge       ( Clock_count_t cycles = 0U ) const = 0;
+  // Batch form of until_*: out[k] = until_*(k) for k in [0,n)
+  virtual void               posedge_times       ( sc_core::sc_time* out, size_t n ) const = 0;
+  virtual void               negedge_times       ( sc_core::sc_time* out, size_t n ) const = 0;
+  virtual void               sample_times        ( sc_core::sc_time* out, size_t n ) const = 0;
+  virtual void               setedge_times       ( sc_core::sc_time* out, size_t n ) const = 0;
   // Wait only if really necessary (for use in SC_THREAD)
   virtual void               wait                ( Clock_count_t cycles = 0U ) = 0;
   virtual void               wait_posedge        ( Clock_count_t cycles = 0U ) = 0;
@@ -0,0 +1,99 @@
+#ifndef NONCLOCK_PORT_HPP
+#define NONCLOCK_PORT_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+// $License: Apache 2.0 $
+//
+// This file is licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Description: sc_port<no_clock_if> with non-virtual access to no_clock.
+//
+// The bound channel is resolved once at end_of_elaboration. If it is a
+// no_clock, the query methods below call the inline no_clock methods directly
+// (no port indirection, no virtual call). Any other no_clock_if implementation
+// (or use before end_of_elaboration) goes through the usual port->method().
+//
+// Example:
+//   no_clock_port clk{"clk"};
+//   ...
+//   if (clk.posedge()) { ... }   // instead of clk->posedge()
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "no_clock.hpp"
+
+class no_clock_port
+: public sc_core::sc_port<no_clock_if>
+{
+public:
+  typedef sc_core::sc_port<no_clock_if> base_type;
+
+  no_clock_port ( void ) : base_type(), m_clock(nullptr) { } //< Constructor
+  explicit no_clock_port ( const char* port_name ) : base_type(port_name), m_clock(nullptr) { } //< Constructor
+
+  const char* kind ( void ) const override { return "no_clock_port"; }
+
+  // Bound no_clock (nullptr before end_of_elaboration or if bound to another no_clock_if)
+  no_clock* clock ( void ) const { return m_clock; }
+
+  // Accessors
+  sc_core::sc_time period    ( Clock_count_t cycles = 1 ) const { return m_clock ? m_clock->no_clock::period(cycles) : (*this)->period(cycles); }
+  double           frequency ( void ) const { return m_clock ? m_clock->no_clock::frequency() : (*this)->frequency(); }
+  // Special conveniences
+  Clock_count_t    cycles    ( void ) const { return m_clock ? m_clock->no_clock::cycles() : (*this)->cycles(); }
+  Clock_count_t    cycles    ( sc_core::sc_time t ) const { return m_clock ? m_clock->no_clock::cycles(t) : (*this)->cycles(t); }
+  // Calculate the delay till... (use for temporal offset)...may return SC_ZERO_TIME if already on the edge
+  sc_core::sc_time until_posedge ( Clock_count_t cycles = 0U ) const { return m_clock ? m_clock->no_clock::until_posedge(cycles) : (*this)->until_posedge(cycles); }
+  sc_core::sc_time until_negedge ( Clock_count_t cycles = 0U ) const { return m_clock ? m_clock->no_clock::until_negedge(cycles) : (*this)->until_negedge(cycles); }
+  sc_core::sc_time until_anyedge ( Clock_count_t cycles = 0U ) const { return m_clock ? m_clock->no_clock::until_anyedge(cycles) : (*this)->until_anyedge(cycles); }
+  sc_core::sc_time until_sample  ( Clock_count_t cycles = 0U ) const { return m_clock ? m_clock->no_clock::until_sample(cycles)  : (*this)->until_sample(cycles);  }
+  sc_core::sc_time until_setedge ( Clock_count_t cycles = 0U ) const { return m_clock ? m_clock->no_clock::until_setedge(cycles) : (*this)->until_setedge(cycles); }
+  // Calculate the delay till... (use for temporal offset)...never returns SC_ZERO_TIME
+  sc_core::sc_time next_posedge  ( Clock_count_t cycles = 0U ) const { return m_clock ? m_clock->no_clock::next_posedge(cycles)  : (*this)->next_posedge(cycles);  }
+  sc_core::sc_time next_negedge  ( Clock_count_t cycles = 0U ) const { return m_clock ? m_clock->no_clock::next_negedge(cycles)  : (*this)->next_negedge(cycles);  }
+  sc_core::sc_time next_anyedge  ( Clock_count_t cycles = 0U ) const { return m_clock ? m_clock->no_clock::next_anyedge(cycles)  : (*this)->next_anyedge(cycles);  }
+  sc_core::sc_time next_sample   ( Clock_count_t cycles = 0U ) const { return m_clock ? m_clock->no_clock::next_sample(cycles)   : (*this)->next_sample(cycles);   }
+  sc_core::sc_time next_setedge  ( Clock_count_t cycles = 0U ) const { return m_clock ? m_clock->no_clock::next_setedge(cycles)  : (*this)->next_setedge(cycles);  }
+  // Wait only if really necessary (for use in SC_THREAD)
+  void wait_posedge ( Clock_count_t cycles = 0U ) { if (m_clock) m_clock->no_clock::wait_posedge(cycles); else (*this)->wait_posedge(cycles); }
+  void wait_negedge ( Clock_count_t cycles = 0U ) { if (m_clock) m_clock->no_clock::wait_negedge(cycles); else (*this)->wait_negedge(cycles); }
+  void wait_anyedge ( Clock_count_t cycles = 0U ) { if (m_clock) m_clock->no_clock::wait_anyedge(cycles); else (*this)->wait_anyedge(cycles); }
+  void wait_sample  ( Clock_count_t cycles = 0U ) { if (m_clock) m_clock->no_clock::wait_sample(cycles);  else (*this)->wait_sample(cycles);  }
+  void wait_setedge ( Clock_count_t cycles = 0U ) { if (m_clock) m_clock->no_clock::wait_setedge(cycles); else (*this)->wait_setedge(cycles); }
+  // Are we there? (use in SC_METHOD)
+  bool at_posedge_time ( void ) const { return m_clock ? m_clock->no_clock::at_posedge_time() : (*this)->at_posedge_time(); }
+  bool posedge         ( void ) const { return at_posedge_time(); }
+  bool at_negedge_time ( void ) const { return m_clock ? m_clock->no_clock::at_negedge_time() : (*this)->at_negedge_time(); }
+  bool negedge         ( void ) const { return at_negedge_time(); }
+  bool at_anyedge_time ( void ) const { return m_clock ? m_clock->no_clock::at_anyedge_time() : (*this)->at_anyedge_time(); }
+  bool event           ( void ) const { return at_anyedge_time(); }
+  bool at_sample_time  ( void ) const { return m_clock ? m_clock->no_clock::at_sample_time()  : (*this)->at_sample_time();  }
+  bool at_setedge_time ( void ) const { return m_clock ? m_clock->no_clock::at_setedge_time() : (*this)->at_setedge_time(); }
+  bool read            ( void ) const { return m_clock ? m_clock->no_clock::read() : (*this)->read(); }
+
+protected:
+  void end_of_elaboration ( void ) override
+  {
+    base_type::end_of_elaboration();
+    m_clock = dynamic_cast<no_clock*>(get_interface());
+  }
+
+private:
+  no_clock* m_clock;
+};
+
+#endif
+
+// TAF!
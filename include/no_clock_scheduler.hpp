@@ -0,0 +1,80 @@
+#ifndef NONCLOCK_SCHEDULER_HPP
+#define NONCLOCK_SCHEDULER_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+// $License: Apache 2.0 $
+//
+// This file is licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Description: Shared lazy notifier for the no_clock compatibility events.
+//
+// Only edges that were subscribed to (i.e. a process was made statically
+// sensitive to posedge_event() etc. during elaboration) are ever notified, and
+// only until every process that subscribed to them has terminated. Edges are
+// computed from sc_time_stamp() (no_clock::edge_ticks), without any time shift.
+// All clocks share a single SC_METHOD and a single wakeup event; pending edges
+// are kept in one time-ordered queue so each activation notifies every edge
+// that is due and then sleeps until the earliest remaining one. A clock that is
+// destroyed takes its entries with it (see forget).
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "no_clock.hpp"
+#include <vector>
+
+class no_clock_scheduler
+{
+public:
+  static no_clock_scheduler& instance ( void ); // created on first use
+
+  void subscribe  ( no_clock& clock, no_clock::edge_kind kind ); // notify kind on every edge
+  void reschedule ( no_clock& clock ); // timing of clock changed
+  static void forget ( no_clock& clock ); // clock is being destroyed: drop its pending entries
+
+  Clock_count_t notifications ( void ) const { return m_notifications; } // events notified so far
+
+private:
+  no_clock_scheduler ( void );
+  no_clock_scheduler(no_clock_scheduler& disallowed __attribute__((unused))) {} // Copy constructor
+  no_clock_scheduler& operator= (no_clock_scheduler& disallowed) {return disallowed;} // Assignment
+
+  struct entry_t
+  {
+    sc_dt::uint64       when;       // absolute ticks
+    no_clock*           clock;
+    no_clock::edge_kind kind;
+    Clock_count_t       generation; // compare with no_clock::m_schedule_generation
+  };
+  struct later_t
+  {
+    bool operator() ( const entry_t& lhs, const entry_t& rhs ) const { return lhs.when > rhs.when; }
+  };
+
+  void schedule ( no_clock& clock, no_clock::edge_kind kind, sc_dt::uint64 when );
+  void wakeup   ( void ); // re-arm m_wakeup for the earliest pending entry
+  static bool sensitive ( no_clock& clock, no_clock::edge_kind kind ); // drops terminated owners (and the edge after the last)
+  void fire     ( void ); // SC_METHOD body
+
+  static no_clock_scheduler* s_instance; // nullptr until first use
+  std::vector<entry_t> m_pending; // heap ordered by later_t (earliest in front)
+  sc_core::sc_event   m_wakeup;
+  sc_dt::uint64       m_armed;  // absolute ticks m_wakeup is armed for (if m_is_armed)
+  bool                m_is_armed;
+  Clock_count_t       m_notifications;
+};
+
+#endif
+
+// TAF!
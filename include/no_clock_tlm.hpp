@@ -0,0 +1,142 @@
+#ifndef NONCLOCK_TLM_HPP
+#define NONCLOCK_TLM_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+// $License: Apache 2.0 $
+//
+// This file is licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Description: TLM conveniences for no_clock (kept separate so that no_clock
+//              itself does not depend on TLM).
+//
+// no_clock_view answers clock queries at the local time of a temporally
+// decoupled initiator (sc_time_stamp() + quantum keeper local time) without
+// calling set_time_shift(), so several initiators may share one clock.
+//
+// Example:
+//   no_clock_view clk(*no_clock::global("sys_clk"), m_qk);
+//   m_qk.inc(clk.until_posedge(2)); // run ahead to the second posedge
+//   if (m_qk.need_sync()) m_qk.sync();
+//
+// The annotate_* helpers advance the delay argument of b_transport to a clock
+// edge relative to sc_time_stamp()+delay, so targets need neither wait() nor
+// set_time_shift():
+//   void b_transport( tlm::tlm_generic_payload& trans, sc_time& delay ) {
+//     annotate_posedge(clk, delay);                       // align to clock
+//     annotate_transfer(clk, trans, delay, 8);            // 8 bytes per cycle
+//   }
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "no_clock.hpp"
+#include <tlm>
+#include <tlm_utils/tlm_quantumkeeper.h>
+
+class no_clock_view
+{
+public:
+  no_clock_view //< Constructor
+  ( const no_clock&              clock
+  , tlm_utils::tlm_quantumkeeper& keeper
+  )
+  : m_clock(clock)
+  , m_keeper(keeper)
+  {
+  }
+
+  const no_clock&  clock      ( void ) const { return m_clock; }
+  sc_core::sc_time local_time ( void ) const { return m_keeper.get_local_time(); }
+  // Special conveniences
+  Clock_count_t    cycles     ( void ) const { return m_clock.cycles(m_keeper.get_current_time()); }
+  // Calculate the delay (relative to local time) till...may return SC_ZERO_TIME if already on the edge
+  sc_core::sc_time until_posedge ( Clock_count_t cycles = 0U ) const { return m_clock.until_posedge(cycles,local_time()); }
+  sc_core::sc_time until_negedge ( Clock_count_t cycles = 0U ) const { return m_clock.until_negedge(cycles,local_time()); }
+  sc_core::sc_time until_anyedge ( Clock_count_t cycles = 0U ) const { return m_clock.until_anyedge(cycles,local_time()); }
+  sc_core::sc_time until_sample  ( Clock_count_t cycles = 0U ) const { return m_clock.until_sample(cycles,local_time());  }
+  sc_core::sc_time until_setedge ( Clock_count_t cycles = 0U ) const { return m_clock.until_setedge(cycles,local_time()); }
+  // Calculate the delay (relative to local time) till...never returns SC_ZERO_TIME
+  sc_core::sc_time next_posedge  ( Clock_count_t cycles = 0U ) const { return m_clock.next_posedge(cycles,local_time());  }
+  sc_core::sc_time next_negedge  ( Clock_count_t cycles = 0U ) const { return m_clock.next_negedge(cycles,local_time());  }
+  sc_core::sc_time next_anyedge  ( Clock_count_t cycles = 0U ) const { return m_clock.next_anyedge(cycles,local_time());  }
+  sc_core::sc_time next_sample   ( Clock_count_t cycles = 0U ) const { return m_clock.next_sample(cycles,local_time());   }
+  sc_core::sc_time next_setedge  ( Clock_count_t cycles = 0U ) const { return m_clock.next_setedge(cycles,local_time());  }
+  // Are we there (at local time)?
+  bool posedge ( void ) const { return until_posedge() == sc_core::SC_ZERO_TIME; }
+  bool negedge ( void ) const { return until_negedge() == sc_core::SC_ZERO_TIME; }
+  // Advance the local time (no context switch) to the edge
+  void inc_to_posedge ( Clock_count_t cycles = 0U ) { m_keeper.inc(until_posedge(cycles)); }
+  void inc_to_negedge ( Clock_count_t cycles = 0U ) { m_keeper.inc(until_negedge(cycles)); }
+  void inc_to_sample  ( Clock_count_t cycles = 0U ) { m_keeper.inc(until_sample(cycles));  }
+  void inc_to_setedge ( Clock_count_t cycles = 0U ) { m_keeper.inc(until_setedge(cycles)); }
+
+private:
+  const no_clock&               m_clock;
+  tlm_utils::tlm_quantumkeeper& m_keeper;
+};
+
+//------------------------------------------------------------------------------
+// Timing annotation: advance delay to the Nth edge at/after sc_time_stamp()+delay
+//------------------------------------------------------------------------------
+inline sc_core::sc_time& annotate_edge
+( const no_clock&     clock
+, sc_core::sc_time&   delay
+, no_clock::edge_kind kind
+, Clock_count_t       cycles = 0U
+)
+{
+  delay += clock.until_edge(kind,cycles,delay);
+  return delay;
+}
+
+inline sc_core::sc_time& annotate_posedge ( const no_clock& clock, sc_core::sc_time& delay, Clock_count_t cycles = 0U )
+{
+  return annotate_edge(clock,delay,no_clock::POSEDGE,cycles);
+}
+
+inline sc_core::sc_time& annotate_negedge ( const no_clock& clock, sc_core::sc_time& delay, Clock_count_t cycles = 0U )
+{
+  return annotate_edge(clock,delay,no_clock::NEGEDGE,cycles);
+}
+
+inline sc_core::sc_time& annotate_sample  ( const no_clock& clock, sc_core::sc_time& delay, Clock_count_t cycles = 0U )
+{
+  return annotate_edge(clock,delay,no_clock::SAMPLE,cycles);
+}
+
+inline sc_core::sc_time& annotate_setedge ( const no_clock& clock, sc_core::sc_time& delay, Clock_count_t cycles = 0U )
+{
+  return annotate_edge(clock,delay,no_clock::SETEDGE,cycles);
+}
+
+//------------------------------------------------------------------------------
+// Advance delay to the posedge that completes the data phase of trans:
+// latency cycles plus ceil(data length / bytes_per_cycle) beats (0 = one beat)
+inline sc_core::sc_time& annotate_transfer
+( const no_clock&                 clock
+, const tlm::tlm_generic_payload& trans
+, sc_core::sc_time&               delay
+, unsigned int                    bytes_per_cycle
+, Clock_count_t                   latency = 0U
+)
+{
+  const unsigned int  length = trans.get_data_length();
+  const Clock_count_t beats  = (bytes_per_cycle == 0 or length == 0)
+                             ? 1 : (length + bytes_per_cycle - 1) / bytes_per_cycle;
+  return annotate_edge(clock,delay,no_clock::POSEDGE,latency + beats);
+}
+
+#endif
+
+// TAF!
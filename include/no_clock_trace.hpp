@@ -0,0 +1,93 @@
+#ifndef NONCLOCK_TRACE_HPP
+#define NONCLOCK_TRACE_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+// $License: Apache 2.0 $
+//
+// This file is licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Description: VCD waveforms of no_clock without any per-edge kernel activity.
+//
+// Edges are computed from each clock's timing when the file is flushed: just
+// before any traced clock changes period, duty, offset, modulation or gating,
+// on flush(), and at end_of_simulation. The edges of all clocks in the file
+// are merged in time order and written out in fixed size chunks, so memory
+// use does not grow with the length of the run. Clocks may be traced until
+// start_of_simulation (or, for a file created while simulating, until its
+// first flush), which writes the header with the values at that time.
+//
+// Example:
+//   no_clock_trace* tf = no_clock_create_vcd_trace_file("clocks"); // clocks.vcd
+//   sc_trace(tf, *clk, "clk");
+//   sc_start(...);
+//   no_clock_close_vcd_trace_file(tf);
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "no_clock.hpp"
+#include <fstream>
+#include <string>
+#include <vector>
+
+class no_clock_trace
+: public sc_core::sc_prim_channel
+{
+public:
+  explicit no_clock_trace ( const char* file_name ); // ".vcd" is appended
+  virtual ~no_clock_trace ( void ); // flushes and closes
+
+  void trace ( const no_clock& clock, const std::string& name ); // before the header (see above)
+  void flush ( void ); // write all edges up to sc_time_stamp()
+
+private:
+  struct signal_t
+  {
+    const no_clock* clock;
+    std::string     name;
+    std::string     id;       // VCD identifier code
+    sc_dt::uint64   posedge;  // next edge times (ticks) after m_flushed
+    sc_dt::uint64   negedge;
+    bool            value;
+  };
+  void write_header ( void );
+  void flush_until  ( sc_dt::uint64 t );
+  void emit         ( sc_dt::uint64 t, const signal_t& signal );
+  void drain        ( void ); // write m_buffer to m_file (called every CHUNK bytes)
+  void forget       ( const no_clock& clock );
+  bool traces       ( const no_clock& clock ) const;
+  void start_of_simulation ( void ) override; // writes the header
+  void end_of_simulation ( void ) override { flush(); }
+  static void change_hook ( const no_clock& clock, bool destroyed ); // see no_clock::before_change
+  // Don't allow copying
+  no_clock_trace ( const no_clock_trace& ) = delete; // Copy constructor
+  no_clock_trace& operator= ( const no_clock_trace& ) = delete; // Assignment
+
+  std::ofstream         m_file;
+  std::string           m_buffer;
+  std::vector<signal_t> m_signals;
+  sc_dt::uint64         m_flushed;   // edges written up to and including this time
+  sc_dt::uint64         m_last_time; // last '#' time stamp written
+  bool                  m_started;   // header written (start_of_simulation or first flush while running)
+  static std::vector<no_clock_trace*> s_files;
+};
+
+// Same shape as sc_create_vcd_trace_file/sc_trace/sc_close_vcd_trace_file
+no_clock_trace* no_clock_create_vcd_trace_file ( const char* file_name );
+void            no_clock_close_vcd_trace_file  ( no_clock_trace* tf );
+void            sc_trace ( no_clock_trace* tf, const no_clock& clock, const std::string& name );
+
+#endif
+
+// TAF!
@@ -0,0 +1,191 @@
+#ifndef STATIC_NONCLOCK_HPP
+#define STATIC_NONCLOCK_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+// $License: Apache 2.0 $
+//
+// This file is licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Description: no_clock with timing fixed at compile time.
+//
+// PERIOD, HIGH (time spent high, i.e. duty*PERIOD) and OFFSET (first posedge)
+// are given in ticks of the SystemC time resolution (sc_get_time_resolution()).
+// All queries reduce to arithmetic on constants (a power-of-two PERIOD becomes
+// a shift/mask). The class is final, so calls through a static_no_clock object
+// or reference are not virtual, yet it still implements no_clock_if and may be
+// bound to sc_port<no_clock_if>.
+//
+// Example (1 ps resolution):
+//   static_no_clock<10000>             clk100("clk100");    // 100 MHz, 50% duty
+//   static_no_clock<8192,2048,1024>    clk("clk");          // 25% duty, shifted
+//
+// The period and offsets never change, so the set_* methods report an error,
+// cycles() counts from time zero and frequency_changes() is always zero.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "no_clock_if.hpp"
+
+template< sc_dt::uint64 PERIOD, sc_dt::uint64 HIGH = PERIOD/2, sc_dt::uint64 OFFSET = 0 >
+class static_no_clock final
+: public sc_core::sc_object
+, public no_clock_if
+{
+  static_assert(PERIOD > 0,                 "Clocks must have a positive non-zero period.");
+  static_assert(HIGH > 0 and HIGH < PERIOD, "Duty cycle must be greater than 0.0 and less than 1.0!");
+  static_assert(OFFSET < PERIOD,            "tOFFSET must be less than period.");
+public:
+  static constexpr sc_dt::uint64 period_ticks  = PERIOD;
+  static constexpr sc_dt::uint64 posedge_ticks = OFFSET;
+  static constexpr sc_dt::uint64 negedge_ticks = (OFFSET + HIGH) % PERIOD;
+  static constexpr sc_dt::uint64 sample_ticks  = posedge_ticks;
+  static constexpr sc_dt::uint64 setedge_ticks = negedge_ticks;
+
+  explicit static_no_clock ( const char* clock_instance ) //< Constructor
+  : sc_core::sc_object(clock_instance)
+  {
+  }
+
+  // Accessors (timing is fixed)
+  void set_frequency    ( double           ) override { fixed(); }
+  void set_period_time  ( sc_core::sc_time ) override { fixed(); }
+  void set_offset_time  ( sc_core::sc_time ) override { fixed(); }
+  void set_duty_cycle   ( double           ) override { fixed(); }
+  void set_sample_time  ( sc_core::sc_time ) override { fixed(); }
+  void set_setedge_time ( sc_core::sc_time ) override { fixed(); }
+  const char*      clock_name ( void ) const override { return basename(); }
+  sc_core::sc_time period     ( Clock_count_t cycles = 1 ) const override { return ticks(cycles*PERIOD); }
+  double           duty       ( void ) const override { return double(HIGH)/double(PERIOD); }
+  double           frequency  ( void ) const override { return sc_core::sc_time(1,sc_core::SC_SEC)/period(); }
+  // Special conveniences
+  Clock_count_t    cycles ( void ) const override { return now() / PERIOD; }
+  Clock_count_t    cycles ( sc_core::sc_time t ) const override { return t.value() / PERIOD; }
+  Clock_count_t    frequency_changes ( void ) const override { return 0; }
+  // Calculate the delay till... (use for temporal offset)...may return SC_ZERO_TIME if already on the edge
+  sc_core::sc_time until_posedge ( Clock_count_t cycles = 0U ) const override { return ticks(cycles*PERIOD + until(posedge_ticks)); }
+  sc_core::sc_time until_negedge ( Clock_count_t cycles = 0U ) const override { return ticks(cycles*PERIOD + until(negedge_ticks)); }
+  sc_core::sc_time until_anyedge ( Clock_count_t cycles = 0U ) const override
+  {
+    const sc_dt::uint64 tPOS = until(posedge_ticks);
+    const sc_dt::uint64 tNEG = until(negedge_ticks);
+    return ticks(cycles*PERIOD + (tNEG < tPOS ? tNEG : tPOS));
+  }
+  sc_core::sc_time until_sample  ( Clock_count_t cycles = 0U ) const override { return ticks(cycles*PERIOD + until(sample_ticks));  }
+  sc_core::sc_time until_setedge ( Clock_count_t cycles = 0U ) const override { return ticks(cycles*PERIOD + until(setedge_ticks)); }
+  // Calculate the delay till... (use for temporal offset)...never returns SC_ZERO_TIME
+  sc_core::sc_time next_posedge ( Clock_count_t cycles = 0U ) const override { return ticks(cycles*PERIOD + next(posedge_ticks)); }
+  sc_core::sc_time next_negedge ( Clock_count_t cycles = 0U ) const override { return ticks(cycles*PERIOD + next(negedge_ticks)); }
+  sc_core::sc_time next_anyedge ( Clock_count_t cycles = 0U ) const override
+  {
+    const sc_dt::uint64 tPOS = next(posedge_ticks);
+    const sc_dt::uint64 tNEG = next(negedge_ticks);
+    return ticks(cycles*PERIOD + (tNEG < tPOS ? tNEG : tPOS));
+  }
+  sc_core::sc_time next_sample  ( Clock_count_t cycles = 0U ) const override { return ticks(cycles*PERIOD + next(sample_ticks));  }
+  sc_core::sc_time next_setedge ( Clock_count_t cycles = 0U ) const override { return ticks(cycles*PERIOD + next(setedge_ticks)); }
+  // Batch form of until_*: out[k] = until_*(k) for k in [0,n)
+  void posedge_times ( sc_core::sc_time* out, size_t n ) const override { fill(out,n,until(posedge_ticks)); }
+  void negedge_times ( sc_core::sc_time* out, size_t n ) const override { fill(out,n,until(negedge_ticks)); }
+  void sample_times  ( sc_core::sc_time* out, size_t n ) const override { fill(out,n,until(sample_ticks));  }
+  void setedge_times ( sc_core::sc_time* out, size_t n ) const override { fill(out,n,until(setedge_ticks)); }
+  // Wait only if really necessary (for use in SC_THREAD)
+  void wait         ( Clock_count_t cycles = 0U ) override { wait_posedge(cycles); }
+  void wait_posedge ( Clock_count_t cycles = 0U ) override { suspend(until_posedge(cycles)); }
+  void wait_negedge ( Clock_count_t cycles = 0U ) override { suspend(until_negedge(cycles)); }
+  void wait_anyedge ( Clock_count_t cycles = 0U ) override { suspend(until_anyedge(cycles)); }
+  void wait_sample  ( Clock_count_t cycles = 0U ) override { suspend(until_sample(cycles));  }
+  void wait_setedge ( Clock_count_t cycles = 0U ) override { suspend(until_setedge(cycles)); }
+  // Are we there? (use in SC_METHOD)
+  bool at_posedge_time ( void ) const override { return phase() == posedge_ticks; }
+  bool posedge         ( void ) const override { return at_posedge_time(); }
+  bool at_negedge_time ( void ) const override { return phase() == negedge_ticks; }
+  bool negedge         ( void ) const override { return at_negedge_time(); }
+  bool at_anyedge_time ( void ) const override { return at_posedge_time() or at_negedge_time(); }
+  bool event           ( void ) const override { return at_anyedge_time(); }
+  bool at_sample_time  ( void ) const override { return phase() == sample_ticks;  }
+  bool at_setedge_time ( void ) const override { return phase() == setedge_ticks; }
+  // For compatibility if you really have/want to: one notification at the next edge
+  // (never blocks; prefer no_clock when static sensitivity is needed)
+  sc_core::sc_event& default_event       ( size_t events = 0 ) override { return value_changed_event(events); }
+  sc_core::sc_event& posedge_event       ( size_t events = 0 ) override { return notify(m_posedge_event, next_posedge(events)); }
+  sc_core::sc_event& negedge_event       ( size_t events = 0 ) override { return notify(m_negedge_event, next_negedge(events)); }
+  sc_core::sc_event& sample_event        ( size_t events = 0 ) override { return notify(m_sample_event,  next_sample(events));  }
+  sc_core::sc_event& setedge_event       ( size_t events = 0 ) override { return notify(m_setedge_event, next_setedge(events)); }
+  sc_core::sc_event& value_changed_event ( size_t events = 0 ) override { return notify(m_anyedge_event, next_anyedge(events)); }
+  bool read ( void ) const override { return until(negedge_ticks) < until(posedge_ticks); }
+  // Utility
+  sc_core::sc_time delay( sc_core::sc_time tPERIOD, sc_core::sc_time tOFFSET, sc_core::sc_time tSHIFT) const override
+  {
+    const sc_dt::uint64 remainder = (now() + tSHIFT.value()) % tPERIOD.value();
+    return ticks( remainder <= tOFFSET.value() ? tOFFSET.value() - remainder : tPERIOD.value() + tOFFSET.value() - remainder );
+  }
+  Clock_count_t clocks( sc_core::sc_time tPERIOD, sc_core::sc_time tZERO, sc_core::sc_time tSHIFT) const override
+  {
+    return (now() + tSHIFT.value() - tZERO.value()) / tPERIOD.value();
+  }
+
+private:
+  static sc_dt::uint64    now   ( void ) { return sc_core::sc_time_stamp().value(); }
+  static sc_dt::uint64    phase ( void ) { return now() % PERIOD; } // constant divisor
+  static sc_core::sc_time ticks ( sc_dt::uint64 t ) { return sc_core::sc_time::from_value(t); }
+  static sc_dt::uint64    until ( sc_dt::uint64 offset )
+  {
+    const sc_dt::uint64 remainder = phase();
+    return ( remainder <= offset ) ? ( offset - remainder ) : ( PERIOD + offset - remainder );
+  }
+  static sc_dt::uint64    next  ( sc_dt::uint64 offset )
+  {
+    const sc_dt::uint64 t = until(offset);
+    return ( 0 == t ) ? PERIOD : t;
+  }
+  static void fill ( sc_core::sc_time* out, size_t n, sc_dt::uint64 first )
+  {
+    for (size_t k = 0; k != n; ++k) out[k] = ticks(first + k*PERIOD);
+  }
+  static void suspend ( const sc_core::sc_time& t )
+  {
+    if (sc_core::SC_ZERO_TIME != t) sc_core::wait(t);
+  }
+  static sc_core::sc_event& notify ( sc_core::sc_event& event, const sc_core::sc_time& t )
+  {
+    event.notify(t);
+    return event;
+  }
+  void fixed ( void ) const
+  {
+    SC_REPORT_ERROR("/xeda/no_clock","static_no_clock timing is fixed at compile time.");
+  }
+  sc_core::sc_event m_anyedge_event;
+  sc_core::sc_event m_posedge_event;
+  sc_core::sc_event m_negedge_event;
+  sc_core::sc_event m_sample_event;
+  sc_core::sc_event m_setedge_event;
+};
+
+// Out-of-class definitions of the constants (needed before C++17 if odr-used)
+template< sc_dt::uint64 PERIOD, sc_dt::uint64 HIGH, sc_dt::uint64 OFFSET >
+constexpr sc_dt::uint64 static_no_clock<PERIOD,HIGH,OFFSET>::period_ticks;
+template< sc_dt::uint64 PERIOD, sc_dt::uint64 HIGH, sc_dt::uint64 OFFSET >
+constexpr sc_dt::uint64 static_no_clock<PERIOD,HIGH,OFFSET>::posedge_ticks;
+template< sc_dt::uint64 PERIOD, sc_dt::uint64 HIGH, sc_dt::uint64 OFFSET >
+constexpr sc_dt::uint64 static_no_clock<PERIOD,HIGH,OFFSET>::negedge_ticks;
+template< sc_dt::uint64 PERIOD, sc_dt::uint64 HIGH, sc_dt::uint64 OFFSET >
+constexpr sc_dt::uint64 static_no_clock<PERIOD,HIGH,OFFSET>::sample_ticks;
+template< sc_dt::uint64 PERIOD, sc_dt::uint64 HIGH, sc_dt::uint64 OFFSET >
+constexpr sc_dt::uint64 static_no_clock<PERIOD,HIGH,OFFSET>::setedge_ticks;
+
+#endif
+
+// TAF!
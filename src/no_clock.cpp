@@ -1,4 +1,5 @@
 #include "no_clock.hpp"
+#include "no_clock_scheduler.hpp"
 
 ///////////////////////////////////////////////////////////////////////////////
 // DESCRIPTION
@@ -22,11 +23,84 @@
 // limitations under the License.
 
 #include <systemc>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
 #include <string>
 using namespace sc_core;
 using namespace std;
 
-no_clock::clock_map_t no_clock::s_global;
+#ifdef __SIZEOF_INT128__
+typedef unsigned __int128 wide_t; // products of two tick counts
+#else
+typedef sc_dt::uint64 wide_t; // unused for rational periods (set_period_ratio keeps den == 1)
+#endif
+
+no_clock::clock_map_t  no_clock::s_global;
+vector<no_clock*>      no_clock::s_handles;
+vector<no_clock*>      no_clock::s_instances;
+no_clock::change_hook_t no_clock::s_change_hook = nullptr;
+bool                   no_clock::s_deriving    = false;
+bool                   no_clock::s_defer       = false;
+size_t                 no_clock::s_deferred_globals = 0;
+
+//------------------------------------------------------------------------------
+// Kernel callbacks on behalf of all clocks (no_clock is not itself a channel)
+class no_clock_hooks
+: public sc_prim_channel
+{
+public:
+  static void install ( void ) // once, while elaborating
+  {
+    static no_clock_hooks* hooks = nullptr;
+    if (hooks == nullptr and sc_get_status() == SC_ELABORATION) hooks = new no_clock_hooks;
+  }
+#ifdef NO_CLOCK_STATS
+  // Query counters are reported once: at end_of_simulation or, failing that
+  // (no sc_stop(), or every clock created while simulating), at exit
+  static void install_report ( void )
+  {
+    static bool registered = false;
+    if (not registered) registered = atexit(&report) == 0;
+    install();
+  }
+  static void report ( void )
+  {
+    static bool reported = false;
+    if (reported) return;
+    reported = true;
+    for (size_t i = 0; i != no_clock::s_instances.size(); ++i) no_clock::s_instances[i]->report_stats();
+    const char* file_name = getenv("NO_CLOCK_STATS_JSON");
+    ofstream json(file_name ? file_name : "no_clock_stats.json");
+    no_clock::write_stats_json(json);
+  }
+#endif
+private:
+  no_clock_hooks ( void ) : sc_prim_channel(sc_gen_unique_name("no_clock_hooks")) { }
+  void end_of_elaboration ( void ) override { no_clock::validate_deferred(); }
+#ifdef NO_CLOCK_STATS
+  void end_of_simulation ( void ) override { report(); } // only counting builds write a report
+#endif
+};
+
+//------------------------------------------------------------------------------
+// Query counters (see NO_CLOCK_STATS)
+struct no_clock::stats_table_t
+{
+  struct process_stats_t
+  {
+    string  name; // copied since dynamic processes may be gone by the report
+    stats_t stats;
+  };
+  // Keyed by handle: holding it keeps a terminated process object (and so its
+  // identity) from being reused by a later dynamic process
+  stats_t                                  total;
+  map<sc_process_handle,process_stats_t>   by_process; // invalid handle: elaboration
+  sc_process_handle                        last_process;
+  stats_t*                                 last = nullptr; // by_process[last_process].stats
+};
 
 no_clock* no_clock::global // Global clock accessor
 ( const char* clock_name
@@ -39,18 +113,24 @@ no_clock* no_clock::global // Global clock accessor
 )
 {
   string message;
-  if (s_global.count(clock_name) != 0) {
+  pair<clock_map_t::iterator,bool> entry(s_global.insert(make_pair(string(clock_name),s_handles.size())));
+  if (not entry.second) {
     message = "Attempt to create global clock with existing name '";
     message += clock_name;
     message += "'";
     SC_REPORT_FATAL("/XtremeEDA/no_clock/global",message.c_str());
   }//endif
-  message = "Creating new global clock '";
-  message += clock_name;
-  message += "'";
-  SC_REPORT_INFO("/XtremeEDA/no_clock/global",message.c_str());
+  if (s_defer) {
+    ++s_deferred_globals; // summarized by validate_deferred
+  } else {
+    message = "Creating new global clock '";
+    message += clock_name;
+    message += "'";
+    SC_REPORT_INFO("/XtremeEDA/no_clock/global",message.c_str());
+  }//endif
+  // Name storage is owned by the registry key so lookups never depend on pointer identity
   no_clock* clock_ptr = new no_clock
-  ( clock_name
+  ( entry.first->first.c_str()
   , tPERIOD
   , duty
   , tOFFSET
@@ -58,11 +138,11 @@ no_clock* no_clock::global // Global clock accessor
   , tSETEDGE
   , positive
   );
-  s_global.insert(make_pair(clock_name,clock_ptr));
+  s_handles.push_back(clock_ptr);
   return clock_ptr;
 }
 
-no_clock* no_clock::global
+no_clock::handle_t no_clock::handle
 ( const char* clock_name
 )
 {
@@ -76,6 +156,130 @@ no_clock* no_clock::global
   return clock_it->second;
 }
 
+no_clock* no_clock::global
+( const char* clock_name
+)
+{
+  return s_handles[handle(clock_name)];
+}
+
+//------------------------------------------------------------------------------
+no_clock* no_clock::derive // Derived (ratio locked) clock
+( const char*   clock_instance
+, no_clock&     parent
+, Clock_count_t mul
+, Clock_count_t div
+, sc_time       tPHASE
+, double        duty
+)
+{
+  if (mul == 0 or div == 0) {
+    SC_REPORT_FATAL("/xeda/no_clock","Derived clock ratio must be non-zero.");
+  }//endif
+  // Collapse onto the root so that every derived clock is one step away
+  no_clock* root_ptr = parent.root();
+  if (root_ptr->is_modulated()) {
+    SC_REPORT_FATAL("/xeda/no_clock","Clocks cannot be derived from a modulated clock.");
+  }//endif
+  if (root_ptr->is_rational()) { // their count would follow the rounded period
+    SC_REPORT_FATAL("/xeda/no_clock","Clocks cannot be derived from a clock with a rational period.");
+  }//endif
+  mul *= parent.m_mul;
+  div *= parent.m_div;
+  Clock_count_t a = mul, b = div;
+  while (b != 0) { Clock_count_t r = a % b; a = b; b = r; }
+  mul /= a;
+  div /= a;
+  const sc_dt::uint64 scaled = root_ptr->m_period_ticks * div;
+  s_deriving = true;
+  no_clock* clock_ptr = new no_clock
+  ( clock_instance
+  , sc_time::from_value(scaled / mul)
+  , duty
+  , tPHASE
+  , tPHASE
+  , tPHASE + duty*sc_time::from_value(scaled / mul)
+  , true
+  );
+  s_deriving = false;
+  clock_ptr->m_root        = root_ptr;
+  clock_ptr->m_mul         = mul;
+  clock_ptr->m_div         = div;
+  clock_ptr->m_exact_ratio = (scaled % mul == 0) and not root_ptr->m_irregular;
+  clock_ptr->m_gated       = root_ptr->m_gated;
+  if (not clock_ptr->m_exact_ratio) {
+    SC_REPORT_WARNING("/xeda/no_clock","Derived clock period is not a whole number of time resolution ticks; rounded.");
+  }//endif
+  clock_ptr->update_ticks();
+  clock_ptr->set_follow_base();
+  root_ptr->m_derived.push_back(clock_ptr);
+  return clock_ptr;
+}
+
+//------------------------------------------------------------------------------
+namespace {
+  // value * to / from rounded to nearest (products of two tick counts overflow 64 bits)
+  sc_dt::uint64 scale_ticks ( sc_dt::uint64 value, sc_dt::uint64 to, sc_dt::uint64 from )
+  {
+#ifdef __SIZEOF_INT128__
+    return sc_dt::uint64( ( wide_t(value) * to + from/2 ) / from );
+#else
+    return sc_dt::uint64( double(value) * double(to) / double(from) + 0.5 );
+#endif
+  }
+}
+
+// Derived clock: the edges as they are now are what follow_root scales (from
+// derive and whenever they are set explicitly)
+void no_clock::set_follow_base
+( void )
+{
+  m_follow_period  = m_period_ticks;
+  m_follow_offset  = m_tOFFSET.value();
+  m_follow_sample  = m_tSAMPLE.value();
+  m_follow_setedge = m_tSETEDGE.value();
+}
+
+//------------------------------------------------------------------------------
+// Derived clock: period follows the root, edges keep their fraction of the period.
+// No frequency change is counted and the cycle base is untouched (cycles() is
+// computed from the root). Edges are scaled from the follow base rather than from
+// their previous values, so rounding does not build up over many changes.
+void no_clock::follow_root
+( void )
+{
+  const sc_dt::uint64 scaled = m_root->m_period_ticks * m_div;
+  m_tPERIOD     = sc_time::from_value(scaled / m_mul);
+  m_exact_ratio = (scaled % m_mul == 0) and not m_root->m_irregular;
+  const sc_dt::uint64 period = m_tPERIOD.value();
+  m_tOFFSET  = sc_time::from_value( scale_ticks(m_follow_offset,  period, m_follow_period) );
+  m_tSAMPLE  = sc_time::from_value( scale_ticks(m_follow_sample,  period, m_follow_period) );
+  m_tSETEDGE = sc_time::from_value( scale_ticks(m_follow_setedge, period, m_follow_period) );
+  m_tPOSEDGE = (m_posedge)?(m_tOFFSET):(m_tOFFSET+m_duty*m_tPERIOD);
+  m_tNEGEDGE = (m_posedge)?(m_tOFFSET+m_duty*m_tPERIOD):(m_tOFFSET);
+  update_ticks();
+  m_timing_changed_event.notify(SC_ZERO_TIME);
+}
+
+//------------------------------------------------------------------------------
+// Root is being destroyed: carry on as a root clock with the same period and
+// phase, counting on from the current count. Earlier history is not kept.
+void no_clock::detach
+( void )
+{
+  const sc_time now(sc_time_stamp());
+  m_base_count      = cycles(now); // through the root, which is still alive
+  m_frequency_set   = now;
+  m_root            = nullptr;
+  m_mul             = 1;
+  m_div             = 1;
+  m_exact_ratio     = true;
+  m_history.clear();
+  m_history_trimmed = true;
+  record_segment();
+  update_ticks();
+}
+
 //------------------------------------------------------------------------------
 no_clock::no_clock //< Constructor
 ( const char*    clock_instance
@@ -95,26 +299,40 @@ no_clock::no_clock //< Constructor
 , m_posedge(positive)
 , m_tSAMPLE(tSAMPLE)
 , m_tSETEDGE(tSETEDGE)
+, m_subscribed(0U)
+, m_cycle_waiters(0U)
+, m_schedule_generation(0UL)
 , m_frequency_set(sc_time_stamp())
 , m_freq_count(0UL)
 , m_base_count(0UL)
+, m_history_depth(0)
+, m_history_trimmed(false)
+, m_root(nullptr)
+, m_mul(1)
+, m_div(1)
+, m_exact_ratio(true)
+, m_follow_period(0)
+, m_follow_offset(0)
+, m_follow_sample(0)
+, m_follow_setedge(0)
 , m_tSHIFT(SC_ZERO_TIME)
+, m_period_num(0)
+, m_period_den(1)
+, m_irregular(false)
+, m_mod_origin(0)
+, m_gated(false)
+, m_gated_requests(0U)
+, m_seq(0U)
+, m_stats(nullptr)
 {
-  if (tPERIOD <= SC_ZERO_TIME) {
-    SC_REPORT_FATAL("/xeda/no_clock","Clocks must have a positive non-zero period.");
-  }//endif
-  if (duty <= 0.0 or 1.0 <= duty) {
-    SC_REPORT_FATAL("/xeda/no_clock","Duty cycle must be greater than 0.0 and less than 1.0!");
-  }//endif
-  if (tOFFSET >= tPERIOD) {
-    SC_REPORT_FATAL("/xeda/no_clock","tOFFSET must be less than period.");
-  }//endif
-  if (tSAMPLE < SC_ZERO_TIME or tSAMPLE >= tPERIOD) {
-    SC_REPORT_FATAL("/xeda/no_clock","tSAMPLE must be non-negative and less than period.");
-  }//endif
-  if (tSETEDGE < SC_ZERO_TIME or tSETEDGE >= tPERIOD) {
-    SC_REPORT_FATAL("/xeda/no_clock","tSETEDGE must be non-negative and less than period.");
-  }//endif
+  if (not s_defer) validate();
+  if (not s_deriving) apply_config(false);
+  update_ticks();
+  record_segment();
+  s_instances.push_back(this);
+#ifdef NO_CLOCK_STATS
+  no_clock_hooks::install_report();
+#endif
 }
 
 //------------------------------------------------------------------------------
@@ -129,29 +347,120 @@ no_clock::no_clock //< Constructor
 , m_tPERIOD(tPERIOD)
 , m_duty(duty)
 , m_tOFFSET(tOFFSET)
+, m_tPOSEDGE((positive)?(tOFFSET):(tOFFSET+duty*m_tPERIOD))
+, m_tNEGEDGE((positive)?(tOFFSET+duty*m_tPERIOD):(tOFFSET))
 , m_posedge(positive)
 , m_tSAMPLE(positive?(tOFFSET):(tOFFSET+(1-duty)*tPERIOD))
 , m_tSETEDGE(positive?(tOFFSET+duty*tPERIOD):(tOFFSET))
+, m_subscribed(0U)
+, m_cycle_waiters(0U)
+, m_schedule_generation(0UL)
 , m_frequency_set(sc_time_stamp())
 , m_freq_count(0UL)
 , m_base_count(0UL)
+, m_history_depth(0)
+, m_history_trimmed(false)
+, m_root(nullptr)
+, m_mul(1)
+, m_div(1)
+, m_exact_ratio(true)
+, m_follow_period(0)
+, m_follow_offset(0)
+, m_follow_sample(0)
+, m_follow_setedge(0)
 , m_tSHIFT(SC_ZERO_TIME)
+, m_period_num(0)
+, m_period_den(1)
+, m_irregular(false)
+, m_mod_origin(0)
+, m_gated(false)
+, m_gated_requests(0U)
+, m_seq(0U)
+, m_stats(nullptr)
 {
-  if (tPERIOD <= SC_ZERO_TIME) {
-    SC_REPORT_FATAL("/xeda/no_clock","Clocks must have a positive non-zero period.");
-  }//endif
-  if (duty <= 0.0 or 1.0 <= duty) {
-    SC_REPORT_FATAL("/xeda/no_clock","Duty cycle must be greater than 0.0 and less than 1.0!");
-  }//endif
-  if (tOFFSET >= tPERIOD) {
-    SC_REPORT_FATAL("/xeda/no_clock","tOFFSET must be less than period.");
+  if (not s_defer) validate();
+  if (not s_deriving) apply_config(true); // sample and setedge come from offset and duty
+  update_ticks();
+  record_segment();
+  s_instances.push_back(this);
+#ifdef NO_CLOCK_STATS
+  no_clock_hooks::install_report();
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Constructor checks (immediately, or for all clocks at end_of_elaboration)
+const char* no_clock::timing_error
+( void ) const
+{
+  if (m_tPERIOD <= SC_ZERO_TIME)                          return "Clocks must have a positive non-zero period.";
+  if (m_duty <= 0.0 or 1.0 <= m_duty)                     return "Duty cycle must be greater than 0.0 and less than 1.0!";
+  if (m_tOFFSET >= m_tPERIOD)                             return "tOFFSET must be less than period.";
+  if (m_tSAMPLE < SC_ZERO_TIME or m_tSAMPLE >= m_tPERIOD)   return "tSAMPLE must be non-negative and less than period.";
+  if (m_tSETEDGE < SC_ZERO_TIME or m_tSETEDGE >= m_tPERIOD) return "tSETEDGE must be non-negative and less than period.";
+  return nullptr;
+}
+
+void no_clock::validate
+( void ) const
+{
+  if (const char* error = timing_error()) SC_REPORT_FATAL("/xeda/no_clock",error);
+}
+
+//------------------------------------------------------------------------------
+void no_clock::defer_validation
+( size_t expected )
+{
+  if (sc_get_status() != SC_ELABORATION) {
+    SC_REPORT_WARNING("/xeda/no_clock","defer_validation() only applies during elaboration; ignored.");
+    return;
   }//endif
-  if (m_tSAMPLE < SC_ZERO_TIME or m_tSAMPLE >= tPERIOD) {
-    SC_REPORT_FATAL("/xeda/no_clock","tSAMPLE must be non-negative and less than period.");
+  s_defer = true;
+  s_deferred_globals = 0;
+  s_instances.reserve(s_instances.size() + expected);
+  s_handles.reserve(s_handles.size() + expected);
+  s_global.reserve(s_global.size() + expected);
+  no_clock_hooks::install();
+}
+
+// One pass and one report for every clock made while deferred
+void no_clock::validate_deferred
+( void )
+{
+  if (not s_defer) return;
+  s_defer = false; // clocks made from now on are checked at once
+  size_t errors = 0;
+  ostringstream os;
+  for (size_t i = 0; i != s_instances.size(); ++i) {
+    const char* error = s_instances[i]->timing_error();
+    if (error == nullptr) continue;
+    if (++errors <= 10) os << "\n  " << s_instances[i]->m_clock_name << ": " << error;
+  }//endfor
+  if (errors != 0) {
+    ostringstream summary;
+    summary << errors << " of " << s_instances.size() << " clocks are invalid" << os.str();
+    if (errors > 10) summary << "\n  ...";
+    SC_REPORT_FATAL("/xeda/no_clock",summary.str().c_str());
+    return;
   }//endif
-  if (m_tSETEDGE < SC_ZERO_TIME or m_tSETEDGE >= tPERIOD) {
-    SC_REPORT_FATAL("/xeda/no_clock","tSETEDGE must be non-negative and less than period.");
+  ostringstream summary;
+  summary << "Validated " << s_instances.size() << " clocks (" << s_deferred_globals << " new global clocks)";
+  SC_REPORT_INFO("/XtremeEDA/no_clock/global",summary.str().c_str());
+}
+
+//------------------------------------------------------------------------------
+no_clock::~no_clock //< Destructor
+( void )
+{
+  before_change(true);
+  no_clock_scheduler::forget(*this);
+  if (m_root != nullptr) {
+    vector<no_clock*>& siblings(m_root->m_derived);
+    siblings.erase(find(siblings.begin(),siblings.end(),this));
   }//endif
+  for (size_t i = 0; i != m_derived.size(); ++i) m_derived[i]->detach();
+  s_instances.erase(find(s_instances.begin(),s_instances.end(),this));
+  delete m_stats;
 }
 
 void no_clock::set_frequency
@@ -160,10 +469,7 @@ void no_clock::set_frequency
   if (frequency <= 0.0) {
     SC_REPORT_FATAL("/xeda/no_clock","Clocks must have a positive non-zero frequency.");
   }//endif
-  ++m_freq_count;
-  m_base_count += cycles();
-  m_tPERIOD = sc_time(1.0/frequency, SC_SEC); 
-  m_frequency_set = sc_time_stamp();
+  change_period(sc_time(1.0/frequency, SC_SEC));
 }
 
 //------------------------------------------------------------------------------
@@ -173,17 +479,155 @@ void no_clock::set_period_time
   if (tPERIOD <= SC_ZERO_TIME) {
     SC_REPORT_FATAL("/xeda/no_clock","Clocks must have a positive non-zero period.");
   }//endif
+  change_period(tPERIOD);
+}
+
+//------------------------------------------------------------------------------
+// Rebase the cycle count to now and start a new history segment
+void no_clock::set_period_ratio
+( const sc_time& tTOTAL, Clock_count_t cycles )
+{
+  sc_dt::uint64 num = tTOTAL.value();
+  sc_dt::uint64 den = cycles;
+  if (den == 0 or num < den) {
+    SC_REPORT_FATAL("/xeda/no_clock","Rational period must be at least one time resolution tick.");
+  }//endif
+  sc_dt::uint64 a = num, b = den;
+  while (b != 0) { sc_dt::uint64 r = a % b; a = b; b = r; }
+  num /= a;
+  den /= a;
+  if (den != 1 and not m_derived.empty()) { // they would follow the rounded period
+    SC_REPORT_ERROR("/xeda/no_clock","Clocks with derived clocks cannot have a rational period.");
+    return;
+  }//endif
+  const sc_time tPERIOD(sc_time::from_value(num / den)); // rounded
+#ifndef __SIZEOF_INT128__
+  if (den != 1) {
+    SC_REPORT_ERROR("/xeda/no_clock","Rational periods need 128-bit integer support; using the rounded period.");
+    num = tPERIOD.value();
+    den = 1;
+  }//endif
+#endif
+  change_period(tPERIOD, num, den);
+}
+
+void no_clock::change_period
+( const sc_time& tPERIOD, sc_dt::uint64 num, sc_dt::uint64 den )
+{
+  if (m_root != nullptr) {
+    SC_REPORT_ERROR("/xeda/no_clock","Derived clocks follow their root; change the frequency of the root instead.");
+    return;
+  }//endif
+  before_change();
+  const sc_time now(sc_time_stamp());
+  m_base_count = cycles(now);
   ++m_freq_count;
-  m_base_count += cycles();
   m_tPERIOD = tPERIOD;
-  m_frequency_set = sc_time_stamp();
+  m_period_num = num;
+  m_period_den = den;
+  m_mod_period.clear();
+  m_mod_start.clear();
+  m_tPOSEDGE = (m_posedge)?(m_tOFFSET):(m_tOFFSET+m_duty*m_tPERIOD);
+  m_tNEGEDGE = (m_posedge)?(m_tOFFSET+m_duty*m_tPERIOD):(m_tOFFSET);
+  m_frequency_set = now;
+  update_ticks();
+  record_segment();
+  for (size_t i = 0; i != m_derived.size(); ++i) m_derived[i]->follow_root();
+  m_timing_changed_event.notify(SC_ZERO_TIME);
+}
+
+//------------------------------------------------------------------------------
+void no_clock::record_segment
+( void )
+{
+  segment_t segment = { m_frequency_set.value(), m_gated ? 0 : m_period_num, m_base_count, m_period_den };
+  if (is_modulated() and not m_gated) {
+    segment.period = m_mod_start.back(); // mean period of the frame
+    segment.den    = m_mod_period.size();
+  }//endif
+  if (not m_history.empty() and m_history.back().time == segment.time) {
+    m_history.back() = segment; // several changes at the same time
+  } else {
+    m_history.push_back(segment);
+  }//endif
+  // Trim in batches so that the cost stays amortized O(1) per change
+  if (m_history_depth != 0 and m_history.size() >= 2*m_history_depth) {
+    m_history.erase(m_history.begin(), m_history.end() - m_history_depth);
+    m_history_trimmed = true;
+  }//endif
+}
+
+//------------------------------------------------------------------------------
+void no_clock::set_history_depth
+( size_t depth )
+{
+  m_history_depth = depth;
+  if (m_history_depth != 0 and m_history.size() > m_history_depth) {
+    m_history.erase(m_history.begin(), m_history.end() - m_history_depth);
+    m_history_trimmed = true;
+  }//endif
+}
+
+//------------------------------------------------------------------------------
+namespace {
+  struct segment_time_less
+  {
+    bool operator() ( sc_dt::uint64 t, const no_clock::segment_t& segment ) const { return t < segment.time; }
+  };
+  struct segment_count_less
+  {
+    bool operator() ( const no_clock::segment_t& segment, Clock_count_t n ) const { return segment.base_count < n; }
+  };
+}
+
+//------------------------------------------------------------------------------
+const no_clock::segment_t& no_clock::find_segment
+( sc_dt::uint64 t ) const
+{
+  vector<segment_t>::const_iterator it
+    ( upper_bound(m_history.begin(), m_history.end(), t, segment_time_less()) );
+  if (it == m_history.begin()) {
+    if (m_history_trimmed) {
+      SC_REPORT_WARNING("/xeda/no_clock","Time precedes the retained frequency history (see set_history_depth).");
+    }//endif
+    return *it; // otherwise before the clock started counting
+  }//endif
+  return *(--it);
+}
+
+//------------------------------------------------------------------------------
+sc_time no_clock::cycle_time
+( Clock_count_t cycle ) const
+{
+  if (m_root != nullptr) { // first root cycle with derived_count() >= cycle
+    return m_root->cycle_time( (cycle / m_mul) * m_div + ( (cycle % m_mul) * m_div + m_mul - 1 ) / m_mul );
+  }//endif
+  if (m_gated and cycle > m_base_count) return sc_max_time(); // not before ungate()
+  if (cycle >= m_base_count and not m_gated) {
+    if (m_irregular) return sc_time::from_value( exact_cycle_time(cycle) );
+    return sc_time::from_value( m_frequency_set.value() + (cycle - m_base_count)*m_period_ticks );
+  }//endif
+  // Last segment that starts below cycle (the count reaches cycle within it)
+  vector<segment_t>::const_iterator it
+    ( lower_bound(m_history.begin(), m_history.end(), cycle, segment_count_less()) );
+  if (it == m_history.begin()) {
+    SC_REPORT_WARNING("/xeda/no_clock","Cycle precedes the retained frequency history (see set_history_depth).");
+    return sc_time::from_value( it->time );
+  }//endif
+  --it;
+  return sc_time::from_value( segment_time(*it,cycle) );
 }
 
 //------------------------------------------------------------------------------
 void no_clock::set_offset_time
 ( sc_time tOFFSET )
 {
+  before_change();
   m_tOFFSET = tOFFSET;
+  m_tPOSEDGE = (m_posedge)?(m_tOFFSET):(m_tOFFSET+m_duty*m_tPERIOD);
+  m_tNEGEDGE = (m_posedge)?(m_tOFFSET+m_duty*m_tPERIOD):(m_tOFFSET);
+  update_ticks();
+  if (m_root != nullptr) set_follow_base();
 }
 
 //------------------------------------------------------------------------------
@@ -193,9 +637,11 @@ void no_clock::set_duty_cycle
   if (duty <= 0.0 or 1.0 <= duty) {
     SC_REPORT_FATAL("/xeda/no_clock","Duty cycle must be greater than 0.0 and less than 1.0!");
   }//endif
+  before_change();
   m_duty = duty;
   m_tPOSEDGE = (m_posedge)?(m_tOFFSET):(m_tOFFSET+duty*m_tPERIOD);
   m_tNEGEDGE = (m_posedge)?(m_tOFFSET+duty*m_tPERIOD):(m_tOFFSET);
+  update_ticks();
 }
 
 //------------------------------------------------------------------------------
@@ -206,6 +652,8 @@ void no_clock::set_sample_time
     SC_REPORT_FATAL("/xeda/no_clock","tSAMPLE must be greater than SC_ZERO_TIME and less than tPERIOD.");
   }//endif
   m_tSAMPLE = tSAMPLE; 
+  update_ticks();
+  if (m_root != nullptr) set_follow_base();
 }
 
 //------------------------------------------------------------------------------
@@ -216,12 +664,714 @@ void no_clock::set_setedge_time
     SC_REPORT_FATAL("/xeda/no_clock","tSETEDGE must be greater than SC_ZERO_TIME and less than tPERIOD.");
   }//endif
   m_tSETEDGE = tSETEDGE; 
+  update_ticks();
+  if (m_root != nullptr) set_follow_base();
+}
+
+//------------------------------------------------------------------------------
+// Refresh the integer tick copies used by the inline query methods (and
+// drop any memoized phase since it was computed from the old values)
+void no_clock::update_ticks
+( void )
+{
+  invalidate_phase();
+  m_period_ticks  = m_tPERIOD.value();
+  if (m_period_ticks == 0) return; // already reported
+  m_posedge_ticks = m_tPOSEDGE.value() % m_period_ticks;
+  m_negedge_ticks = m_tNEGEDGE.value() % m_period_ticks;
+  m_sample_ticks  = m_tSAMPLE.value()  % m_period_ticks;
+  m_setedge_ticks = m_tSETEDGE.value() % m_period_ticks;
+  m_shift_ticks   = m_tSHIFT.value();
+  if (m_period_den == 1) m_period_num = m_period_ticks;
+  m_irregular     = is_rational() or is_modulated();
+  publish();
+  if (m_subscribed != 0U) no_clock_scheduler::instance().reschedule(*this);
+}
+
+//------------------------------------------------------------------------------
+// Rational period: scale time by den so that the period (num) is exact, then
+// round edges up to the next tick. Inclusive queries accept an exact edge in
+// (t-1,t], which is the one that rounds to t.
+namespace {
+  // Delay from t to the edge at offset into a period of num/den ticks (see above)
+  sc_dt::uint64 rational_delay_ticks
+  ( sc_dt::uint64 period_num, sc_dt::uint64 period_den, sc_dt::uint64 offset
+  , sc_dt::uint64 t, Clock_count_t cycles, bool inclusive )
+  {
+    const wide_t num   = period_num;
+    const wide_t den   = period_den;
+    const wide_t start = inclusive ? ( t == 0 ? 0 : wide_t(t)*den - den + 1 ) : wide_t(t)*den + 1;
+    const wide_t edge  = wide_t(offset)*den;
+    const wide_t phase = start % num;
+    const wide_t exact = start + ( phase <= edge ? edge - phase : num + edge - phase ) + wide_t(cycles)*num;
+    return sc_dt::uint64( ( exact + den - 1 ) / den - t );
+  }
 }
 
+Clock_count_t no_clock::segment_cycles
+( const segment_t& segment, sc_dt::uint64 t )
+{
+  return segment.base_count
+       + Clock_count_t( wide_t( t - segment.time ) * segment.den / segment.period );
+}
+
+sc_dt::uint64 no_clock::segment_time
+( const segment_t& segment, Clock_count_t cycle )
+{
+  return segment.time
+       + sc_dt::uint64( ( wide_t( cycle - segment.base_count ) * segment.period + segment.den - 1 ) / segment.den );
+}
+
+sc_dt::uint64 no_clock::exact_delay_ticks
+( edge_kind kind, sc_dt::uint64 t, Clock_count_t cycles, bool inclusive ) const
+{
+  sc_dt::uint64 offset = 0;
+  switch (kind) {
+    case POSEDGE: offset = m_posedge_ticks; break;
+    case NEGEDGE: offset = m_negedge_ticks; break;
+    case SAMPLE:  offset = m_sample_ticks;  break;
+    case SETEDGE: offset = m_setedge_ticks; break;
+    case ANYEDGE: {
+      const sc_dt::uint64 tPOS = exact_delay_ticks(POSEDGE,t,cycles,inclusive);
+      const sc_dt::uint64 tNEG = exact_delay_ticks(NEGEDGE,t,cycles,inclusive);
+      return (tNEG < tPOS) ? tNEG : tPOS;
+    }
+  }//endswitch
+  if (is_modulated()) return modulated_delay_ticks(offset,t,cycles,inclusive);
+  return rational_delay_ticks(m_period_num,m_period_den,offset,t,cycles,inclusive);
+}
+
+Clock_count_t no_clock::exact_cycles
+( sc_dt::uint64 t ) const
+{
+  if (not is_modulated()) return segment_cycles(m_history.back(),t);
+  return m_base_count + modulated_index(t) - modulated_index(m_frequency_set.value());
+}
+
+sc_dt::uint64 no_clock::exact_cycle_time
+( Clock_count_t cycle ) const
+{
+  if (not is_modulated()) return segment_time(m_history.back(),cycle);
+  const size_t        n     = m_mod_period.size();
+  const Clock_count_t index = cycle - m_base_count + modulated_index(m_frequency_set.value());
+  return m_mod_origin + (index / n) * m_mod_start.back() + m_mod_start[index % n];
+}
+
+// Same for a snapshot (any thread): what no_clock::exact_cycles and
+// exact_delay_ticks compute from the published num/den
+Clock_count_t no_clock::snapshot_t::exact_cycles
+( sc_dt::uint64 t ) const
+{
+  if (t <= frequency_set or gated) return base_count;
+  return base_count + Clock_count_t( wide_t( t - frequency_set ) * period_den / period_num );
+}
+
+sc_dt::uint64 no_clock::snapshot_t::exact_until_edge
+( edge_kind kind, sc_dt::uint64 t, Clock_count_t cycles ) const
+{
+  switch (kind) {
+    case POSEDGE: return rational_delay_ticks(period_num,period_den,posedge,t,cycles,true);
+    case NEGEDGE: return rational_delay_ticks(period_num,period_den,negedge,t,cycles,true);
+    case SAMPLE:  return rational_delay_ticks(period_num,period_den,sample,t,cycles,true);
+    case SETEDGE: return rational_delay_ticks(period_num,period_den,setedge,t,cycles,true);
+    case ANYEDGE: {
+      const sc_dt::uint64 tPOS = exact_until_edge(POSEDGE,t,cycles);
+      const sc_dt::uint64 tNEG = exact_until_edge(NEGEDGE,t,cycles);
+      return (tNEG < tPOS) ? tNEG : tPOS;
+    }
+  }//endswitch
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Modulation: cycle k of the frame starts at m_mod_start[k] and each edge sits at
+// its nominal fraction of that cycle's period
+Clock_count_t no_clock::modulated_index
+( sc_dt::uint64 t ) const
+{
+  const sc_dt::uint64 u     = t > m_mod_origin ? t - m_mod_origin : 0;
+  const sc_dt::uint64 frame = m_mod_start.back();
+  const sc_dt::uint64 w     = u % frame;
+  const size_t        k     = upper_bound(m_mod_start.begin(), m_mod_start.end() - 1, w) - m_mod_start.begin() - 1;
+  return (u / frame) * m_mod_period.size() + k;
+}
+
+sc_dt::uint64 no_clock::modulated_delay_ticks
+( sc_dt::uint64 offset, sc_dt::uint64 t, Clock_count_t cycles, bool inclusive ) const
+{
+  const size_t        n       = m_mod_period.size();
+  const sc_dt::uint64 frame   = m_mod_start.back();
+  const sc_dt::uint64 nominal = m_period_ticks;
+  const sc_dt::uint64 u       = t > m_mod_origin ? t - m_mod_origin : 0;
+  Clock_count_t       index   = modulated_index(t);
+  // Edge of cycle index, relative to m_mod_origin
+  sc_dt::uint64 k    = index % n;
+  sc_dt::uint64 edge = (index / n) * frame + m_mod_start[k] + sc_dt::uint64( wide_t(offset) * m_mod_period[k] / nominal );
+  if (edge < u or (edge == u and not inclusive)) ++index;
+  index += cycles;
+  k    = index % n;
+  edge = (index / n) * frame + m_mod_start[k] + sc_dt::uint64( wide_t(offset) * m_mod_period[k] / nominal );
+  return m_mod_origin + edge - t;
+}
+
+void no_clock::set_modulation
+( const vector<sc_time>& profile )
+{
+  if (m_root != nullptr) {
+    SC_REPORT_ERROR("/xeda/no_clock","Derived clocks follow their root; modulate the root instead.");
+    return;
+  }//endif
+  if (not m_derived.empty()) { // their edges would advance at the nominal period
+    SC_REPORT_ERROR("/xeda/no_clock","Clocks with derived clocks cannot be modulated.");
+    return;
+  }//endif
+  if (profile.empty()) {
+    SC_REPORT_ERROR("/xeda/no_clock","Modulation profile must not be empty.");
+    return;
+  }//endif
+  before_change();
+  const sc_time now(sc_time_stamp());
+  m_base_count = cycles(now);
+  ++m_freq_count;
+  m_period_den = 1;
+  m_mod_period.clear();
+  m_mod_start.assign(1,0);
+  for (size_t k = 0; k != profile.size(); ++k) {
+    if (profile[k] <= SC_ZERO_TIME) {
+      SC_REPORT_FATAL("/xeda/no_clock","Clocks must have a positive non-zero period.");
+    }//endif
+    m_mod_period.push_back(profile[k].value());
+    m_mod_start.push_back(m_mod_start.back() + profile[k].value());
+  }//endfor
+  m_mod_origin    = now.value();
+  m_frequency_set = now;
+  update_ticks();
+  record_segment();
+  for (size_t i = 0; i != m_derived.size(); ++i) m_derived[i]->follow_root();
+  m_timing_changed_event.notify(SC_ZERO_TIME);
+}
+
+void no_clock::clear_modulation
+( void )
+{
+  if (is_modulated()) change_period(m_tPERIOD);
+}
+
+vector<sc_time> no_clock::ssc_profile
+( const sc_time& tPERIOD, double spread, size_t cycles )
+{
+  if (spread < 0.0 or 1.0 <= spread) {
+    SC_REPORT_FATAL("/xeda/no_clock","Spread must be at least 0.0 and less than 1.0.");
+  }//endif
+  vector<sc_time> profile;
+  profile.reserve(cycles);
+  for (size_t k = 0; k != cycles; ++k) {
+    const double triangle = 2.0 * ( k < cycles/2 ? k : cycles - k ) / double(cycles); // 0..1..0
+    profile.push_back(tPERIOD / (1.0 - spread*triangle));
+  }//endfor
+  return profile;
+}
+
+vector<sc_time> no_clock::jitter_profile
+( const sc_time& tPERIOD, const sc_time& tJITTER, size_t cycles, unsigned seed )
+{
+  if (tJITTER >= tPERIOD) {
+    SC_REPORT_FATAL("/xeda/no_clock","Jitter must be less than the period.");
+  }//endif
+  const sc_dt::uint64 period = tPERIOD.value();
+  const sc_dt::uint64 jitter = tJITTER.value();
+  sc_dt::uint64 state = seed;
+  vector<sc_time> profile;
+  profile.reserve(cycles);
+  for (size_t k = 0; k != cycles; ++k) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL; // LCG (Knuth MMIX)
+    const sc_dt::uint64 draw = (state >> 33) % (2*jitter + 1);      // 0..2*jitter
+    profile.push_back(sc_time::from_value(period - jitter + draw));
+  }//endfor
+  return profile;
+}
+
+//------------------------------------------------------------------------------
+// Compatibility events never block; see no_clock_scheduler for the static case
+sc_event& no_clock::edge_event
+( edge_kind kind, size_t events )
+{
+  NO_CLOCK_STAT(STAT_EVENT);
+  sc_event& event(edge_event_ref(kind));
+  if (not sc_is_running()) {
+    no_clock_scheduler::instance().subscribe(*this,kind);
+  } else if (m_gated) {
+    m_gated_requests |= 1U << kind; // notified by ungate()
+  } else if ((m_subscribed & (1U << kind)) == 0U) {
+    // Same as next_edge(kind,events), unshifted and without counting it as a query
+    event.notify(sc_time::from_value(event_delay_ticks(kind,events,false)));
+  }//endif
+  return event;
+}
+
+//------------------------------------------------------------------------------
+sc_event& no_clock::edge_event_ref
+( edge_kind kind )
+{
+  switch (kind) {
+    case POSEDGE: return m_posedge_event;
+    case NEGEDGE: return m_negedge_event;
+    case ANYEDGE: return m_anyedge_event;
+    case SAMPLE:  return m_sample_event;
+    case SETEDGE: return m_setedge_event;
+  }//endswitch
+  return m_anyedge_event;
+}
+
+//------------------------------------------------------------------------------
+// Absolute time (ticks) of the first edge of kind after t (or at t if inclusive);
+// ignores m_tSHIFT since it is used to notify real events
+sc_dt::uint64 no_clock::edge_ticks
+( edge_kind kind, sc_dt::uint64 t, bool inclusive ) const
+{
+  if (m_irregular) return t + exact_delay_ticks(kind, t, 0, inclusive);
+  return t + edge_delay_ticks(kind, t % m_period_ticks, inclusive);
+}
+
+//------------------------------------------------------------------------------
+// Sleep straight to an absolute cycle; wakes early only to recompute if the
+// period or cycle base changes in the meantime
+void no_clock::wait_until_cycle
+( Clock_count_t cycle )
+{
+  NO_CLOCK_STAT(STAT_WAIT);
+  if (cycles() >= cycle) {
+    NO_CLOCK_STAT(STAT_ZERO_WAIT);
+    NO_CLOCK_WAIT_STAT(0);
+    return;
+  }//endif
+  NO_CLOCK_WAIT_STAT( (cycle - cycles()) * m_period_ticks );
+  ++m_cycle_waiters;
+  while (cycles() < cycle) {
+    const sc_dt::uint64 now    = sc_time_stamp().value() + m_shift_ticks;
+    const sc_dt::uint64 target = cycle_time(cycle).value();
+    NO_CLOCK_STAT(STAT_SUSPEND);
+    sc_core::wait(sc_time::from_value(target > now ? target - now : 0), m_timing_changed_event);
+  }//endwhile
+  --m_cycle_waiters;
+}
+
+//------------------------------------------------------------------------------
+// If the thread already fell behind (it waited on something else), the
+// budget restarts from the present without waiting
+void no_clock::cycle_budget::sync
+( void )
+{
+  if (m_pending == 0U) return;
+  const Clock_count_t goal = target();
+  m_pending = 0U;
+  m_clock.wait_until_cycle(goal);
+  m_origin = m_clock.cycles();
+}
+
+sc_time no_clock::cycle_budget::local_time
+( void ) const
+{
+  const sc_time now(sc_time_stamp());
+  const sc_time when(m_clock.cycle_time(target()));
+  return (when > now) ? (when - now) : SC_ZERO_TIME;
+}
+
+//------------------------------------------------------------------------------
+// Clock gating: the cycle count is frozen by a period 0 history segment
+void no_clock::gate
+( void )
+{
+  if (m_root != nullptr) {
+    SC_REPORT_ERROR("/xeda/no_clock","Derived clocks follow their root; gate the root instead.");
+    return;
+  }//endif
+  set_gated(true);
+}
+
+void no_clock::ungate
+( void )
+{
+  if (m_root != nullptr) {
+    SC_REPORT_ERROR("/xeda/no_clock","Derived clocks follow their root; ungate the root instead.");
+    return;
+  }//endif
+  set_gated(false);
+}
+
+void no_clock::set_gated
+( bool gated )
+{
+  if (gated == m_gated) return;
+  before_change();
+  const sc_time now(sc_time_stamp());
+  if (m_root == nullptr) {
+    m_base_count    = cycles(now); // count so far (already frozen if ungating)
+    m_frequency_set = now;
+  }//endif
+  m_gated = gated;
+  if (m_root == nullptr) record_segment();
+  invalidate_phase();
+  publish();
+  for (size_t i = 0; i != m_derived.size(); ++i) m_derived[i]->set_gated(gated);
+  if (m_subscribed != 0U) no_clock_scheduler::instance().reschedule(*this); // stops or restarts the events
+  if (not gated) release_gated();
+  m_timing_changed_event.notify(SC_ZERO_TIME);
+}
+
+// Just ungated: wake the gated wait_* callers and the one-shot events requested meanwhile
+void no_clock::release_gated
+( void )
+{
+  const sc_dt::uint64 now = sc_time_stamp().value();
+  m_ungate_event.notify(SC_ZERO_TIME);
+  for (unsigned kind = POSEDGE; kind <= SETEDGE; ++kind) {
+    if (m_gated_requests & (1U << kind)) {
+      edge_event_ref(edge_kind(kind)).notify
+        ( sc_time::from_value(edge_ticks(edge_kind(kind),now,true) - now) );
+    }//endif
+  }//endfor
+  m_gated_requests = 0U;
+}
+
+//------------------------------------------------------------------------------
+// wait_* while gated: one wakeup at ungate(), then on to the next aligned edge
+void no_clock::wait_ungated
+( edge_kind kind, Clock_count_t cycles )
+{
+  for (;;) {
+    while (m_gated) {
+      NO_CLOCK_STAT(STAT_SUSPEND);
+      sc_core::wait(m_ungate_event);
+    }//endwhile
+    const sc_dt::uint64 ticks = m_irregular
+                              ? exact_delay_ticks(kind,cycles,true)
+                              : cycles*m_period_ticks + edge_delay_ticks(kind,phase_ticks(),true);
+    if (0 == ticks) return;
+    NO_CLOCK_STAT(STAT_SUSPEND);
+    sc_core::wait(sc_time::from_value(ticks));
+    if (not m_gated) return;
+    cycles = 0; // gated again while asleep
+  }//endfor
+}
+
+//------------------------------------------------------------------------------
+// Setup/hold window: legal writes lie in [sample, setedge] of a cycle
+namespace {
+  no_clock::window_check_t window_result ( sc_dt::uint64 hold, sc_dt::uint64 setup, bool ok )
+  {
+    no_clock::window_check_t result;
+    result.ok    = ok;
+    result.setup = setup <= hold;
+    const sc_dt::int64 margin = sc_dt::int64(result.setup ? setup : hold);
+    result.slack = ok ? margin : -margin;
+    return result;
+  }
+}
+
+bool no_clock::last_edge_ticks
+( edge_kind kind, sc_dt::uint64 t, sc_dt::uint64& edge ) const
+{
+  const sc_dt::uint64 back = 2*m_period_ticks; // covers modulated cycles near the nominal period
+  edge = edge_ticks(kind, t > back ? t - back : 0, true);
+  if (edge > t) return false; // before the first one
+  for (sc_dt::uint64 next = edge_ticks(kind,edge); next <= t; next = edge_ticks(kind,edge)) edge = next;
+  return true;
+}
+
+no_clock::window_check_t no_clock::window_ticks
+( sc_dt::uint64 w ) const
+{
+  if (m_gated) return window_result(~sc_dt::uint64(0) >> 1, ~sc_dt::uint64(0) >> 1, true);
+  if (not m_irregular) {
+    // Phase arithmetic: since = ticks since the last sample, open = window length
+    const sc_dt::uint64 P     = m_period_ticks;
+    const sc_dt::uint64 since = (w % P + P - m_sample_ticks) % P;
+    const sc_dt::uint64 open  = (m_setedge_ticks + P - m_sample_ticks) % P;
+    if (since <= open) return window_result(since, open - since, true);
+    return window_result(P - since, since - open, false); // hold of the next sample, setup of the last setedge
+  }//endif
+  // Rational or modulated: from the actual edges around w
+  const sc_dt::uint64 next_sample  = edge_ticks(SAMPLE,w,true);
+  const sc_dt::uint64 next_setedge = edge_ticks(SETEDGE,w,true);
+  sc_dt::uint64 last_sample, last_setedge;
+  const bool    sampled = last_edge_ticks(SAMPLE,w,last_sample);
+  const bool    set     = last_edge_ticks(SETEDGE,w,last_setedge);
+  if (next_setedge < edge_ticks(SAMPLE,w) or next_sample == w) { // inside: the setedge comes first
+    return window_result(sampled ? w - last_sample : next_setedge - w, next_setedge - w, true);
+  }//endif
+  return window_result(next_sample - w, set ? w - last_setedge : next_sample - w, false);
+}
+
+no_clock::window_check_t no_clock::check_window
+( const sc_time& tWRITE ) const
+{
+  return window_ticks(tWRITE.value());
+}
+
+void no_clock::check_window
+( const sc_dt::uint64* write_ticks, window_check_t* out, size_t n ) const
+{
+  for (size_t i = 0; i != n; ++i) out[i] = window_ticks(write_ticks[i]);
+}
+
+void no_clock::check_crossing
+( const no_clock& writer, const sc_time& tFROM, window_check_t* out, size_t n ) const
+{
+  if (n == 0) return;
+  sc_dt::uint64 write = writer.edge_ticks(SETEDGE,tFROM.value(),true);
+  for (size_t i = 0; i != n; ++i) {
+    out[i] = window_ticks(write);
+    write  = writer.edge_ticks(SETEDGE,write);
+  }//endfor
+}
+
+//------------------------------------------------------------------------------
+// Coroutine form of suspend()/wait_ungated(): the same decisions, but each
+// sleep is a next_trigger() of the driving SC_METHOD
+sc_dt::uint64 no_clock::wait_ticks
+( edge_kind kind, Clock_count_t cycles ) const
+{
+  return m_irregular ? exact_delay_ticks(kind,cycles,true)
+                     : cycles*m_period_ticks + edge_delay_ticks(kind,phase_ticks(),true);
+}
+
+bool no_clock::await_ready
+( edge_awaitable_t& awaitable )
+{
+  NO_CLOCK_STAT(STAT_WAIT);
+  awaitable.gated = m_gated;
+  if (m_gated) return false;
+  const sc_dt::uint64 ticks = wait_ticks(awaitable.kind,awaitable.cycles);
+  NO_CLOCK_WAIT_STAT(ticks);
+  if (0 == ticks) {
+    NO_CLOCK_STAT(STAT_ZERO_WAIT);
+    return true;
+  }//endif
+  return false;
+}
+
+void no_clock::await_suspend
+( edge_awaitable_t& awaitable )
+{
+  NO_CLOCK_STAT(STAT_SUSPEND);
+  if (awaitable.gated) {
+    sc_core::next_trigger(m_ungate_event);
+  } else {
+    sc_core::next_trigger(sc_time::from_value(wait_ticks(awaitable.kind,awaitable.cycles)));
+  }//endif
+}
+
+bool no_clock::await_poll
+( edge_awaitable_t& awaitable )
+{
+  if (m_gated) {
+    if (not awaitable.gated) awaitable.cycles = 0; // gated while asleep
+    awaitable.gated = true;
+    NO_CLOCK_STAT(STAT_SUSPEND);
+    sc_core::next_trigger(m_ungate_event);
+    return false;
+  }//endif
+  if (not awaitable.gated) return true; // slept to the edge
+  // Just ungated: on to the next aligned edge
+  awaitable.gated = false;
+  const sc_dt::uint64 ticks = wait_ticks(awaitable.kind,awaitable.cycles);
+  if (0 == ticks) return true;
+  NO_CLOCK_STAT(STAT_SUSPEND);
+  sc_core::next_trigger(sc_time::from_value(ticks));
+  return false;
+}
+
+//------------------------------------------------------------------------------
+void no_clock::wait_aligned
+( const sc_event& event, edge_kind kind )
+{
+  NO_CLOCK_STAT(STAT_SUSPEND);
+  sc_core::wait(event);
+  wait_edge(kind);
+}
+
+//------------------------------------------------------------------------------
 void no_clock::reset //< Clears count & frequency change base
 ( void )
 {
-  SC_REPORT_FATAL("/xeda/no_clock","Not yet implemented"); // {:TODO:}
+  // Constant time: no events, no allocation (history keeps its capacity),
+  // clock phase and period are unaffected
+  if (m_root != nullptr) {
+    SC_REPORT_ERROR("/xeda/no_clock","Derived clocks count with their root; reset the root instead.");
+    return;
+  }//endif
+  m_base_count    = 0;
+  m_frequency_set = sc_time_stamp();
+  m_history.clear();
+  m_history_trimmed = false;
+  record_segment();
+  invalidate_phase();
+  publish();
+  // Except that threads asleep in wait_until_cycle (if any) recompute their wakeup
+  for (size_t i = 0; i != m_derived.size(); ++i) {
+    m_derived[i]->invalidate_phase(); // memoized count of the root
+    m_derived[i]->publish();
+    if (m_derived[i]->m_cycle_waiters != 0U) m_derived[i]->m_timing_changed_event.notify(SC_ZERO_TIME);
+  }//endfor
+  if (m_cycle_waiters != 0U) m_timing_changed_event.notify(SC_ZERO_TIME);
+}
+
+//------------------------------------------------------------------------------
+// Seqlock writer: never waits for readers
+void no_clock::publish
+( void )
+{
+  const no_clock& counter(m_root ? *m_root : *this);
+  const unsigned seq = m_seq.load(memory_order_relaxed);
+  m_seq.store(seq + 1U, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  m_snap[SNAP_PERIOD].store(m_period_ticks, memory_order_relaxed);
+  m_snap[SNAP_POSEDGE].store(m_posedge_ticks, memory_order_relaxed);
+  m_snap[SNAP_NEGEDGE].store(m_negedge_ticks, memory_order_relaxed);
+  m_snap[SNAP_SAMPLE].store(m_sample_ticks, memory_order_relaxed);
+  m_snap[SNAP_SETEDGE].store(m_setedge_ticks, memory_order_relaxed);
+  m_snap[SNAP_COUNT_PERIOD].store(counter.m_period_ticks, memory_order_relaxed);
+  m_snap[SNAP_FREQUENCY_SET].store(counter.m_frequency_set.value(), memory_order_relaxed);
+  m_snap[SNAP_BASE_COUNT].store(counter.m_base_count, memory_order_relaxed);
+  m_snap[SNAP_MUL].store(m_mul, memory_order_relaxed);
+  m_snap[SNAP_DIV].store(m_div, memory_order_relaxed);
+  m_snap[SNAP_FREQ_COUNT].store(counter.m_freq_count, memory_order_relaxed);
+  m_snap[SNAP_GATED].store(counter.m_gated ? 1 : 0, memory_order_relaxed);
+  m_snap[SNAP_PERIOD_NUM].store(m_period_num, memory_order_relaxed);
+  m_snap[SNAP_PERIOD_DEN].store(m_period_den, memory_order_relaxed);
+  m_seq.store(seq + 2U, memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+// Instrumentation (counting is compiled in by NO_CLOCK_STATS)
+// Single-threaded like the kernel: each process only ever touches its own
+// entry, so no locking or atomics are needed
+no_clock::stats_t& no_clock::process_stats
+( void ) const
+{
+  if (m_stats == nullptr) m_stats = new stats_table_t();
+  const sc_process_handle process(sc_is_running() ? sc_get_current_process_handle() : sc_process_handle());
+  if (m_stats->last == nullptr or process != m_stats->last_process) {
+    stats_table_t::process_stats_t& entry(m_stats->by_process[process]);
+    if (entry.name.empty()) entry.name = process.valid() ? process.name() : "(elaboration)";
+    m_stats->last_process = process;
+    m_stats->last         = &entry.stats;
+  }//endif
+  return *m_stats->last;
+}
+
+void no_clock::count_stat
+( stat_kind kind ) const
+{
+  ++process_stats().count[kind];
+  ++m_stats->total.count[kind];
+}
+
+void no_clock::count_wait
+( sc_dt::uint64 ticks ) const
+{
+  Clock_count_t cycles = m_period_ticks ? ticks / m_period_ticks : 0;
+  size_t bucket = 0;
+  while (cycles != 0) { ++bucket; cycles >>= 1; }
+  ++process_stats().waits[bucket];
+  ++m_stats->total.waits[bucket];
+}
+
+const no_clock::stats_t* no_clock::stats
+( void ) const
+{
+  return m_stats ? &m_stats->total : nullptr;
+}
+
+namespace {
+  void format_stats( ostringstream& os, const no_clock::stats_t& stats )
+  {
+    static const char* const label[no_clock::STAT_KINDS] =
+      { "until", "next", "wait", "at", "read", "event", "suspend", "zero_wait" };
+    for (int kind = 0; kind != no_clock::STAT_KINDS; ++kind) {
+      os << (kind ? " " : "") << label[kind] << "=" << stats.count[kind];
+    }//endfor
+  }
+}
+
+namespace {
+  void format_waits( ostringstream& os, const no_clock::stats_t& stats )
+  {
+    size_t used = no_clock::WAIT_BUCKETS;
+    while (used != 0 and stats.waits[used-1] == 0) --used;
+    os << '[';
+    for (size_t bucket = 0; bucket != used; ++bucket) os << (bucket ? "," : "") << stats.waits[bucket];
+    os << ']';
+  }
+
+  void format_json( ostringstream& os, const no_clock::stats_t& stats )
+  {
+    static const char* const label[no_clock::STAT_KINDS] =
+      { "until", "next", "wait", "at", "read", "event", "suspend", "zero_wait" };
+    for (int kind = 0; kind != no_clock::STAT_KINDS; ++kind) {
+      os << '"' << label[kind] << "\":" << stats.count[kind] << ',';
+    }//endfor
+    os << "\"wait_cycles_log2\":";
+    format_waits(os,stats);
+  }
+
+  string json_string( const string& text )
+  {
+    string result("\"");
+    for (size_t i = 0; i != text.size(); ++i) {
+      if (text[i] == '"' or text[i] == '\\') result += '\\';
+      result += text[i];
+    }//endfor
+    return result + '"';
+  }
+}
+
+//------------------------------------------------------------------------------
+// {"clocks":[{"name":..,"period_ticks":..,"total":{..},"processes":[{"name":..,..}]}]}
+void no_clock::write_stats_json
+( ostream& os )
+{
+  ostringstream json;
+  json << "{\"clocks\":[";
+  bool first = true;
+  for (size_t i = 0; i != s_instances.size(); ++i) {
+    const no_clock& clock(*s_instances[i]);
+    if (clock.m_stats == nullptr) continue;
+    json << (first ? "" : ",") << "\n {\"name\":" << json_string(clock.m_clock_name)
+         << ",\"period_ticks\":" << clock.m_period_ticks << ",\"total\":{";
+    format_json(json,clock.m_stats->total);
+    json << "},\"processes\":[";
+    bool first_process = true;
+    for (const auto& entry : clock.m_stats->by_process) {
+      json << (first_process ? "" : ",") << "\n  {\"name\":" << json_string(entry.second.name) << ',';
+      format_json(json,entry.second.stats);
+      json << '}';
+      first_process = false;
+    }//endfor
+    json << "]}";
+    first = false;
+  }//endfor
+  json << "\n]}\n";
+  os << json.str();
+}
+
+void no_clock::report_stats
+( void ) const
+{
+  if (m_stats == nullptr) return;
+  ostringstream os;
+  os << "Clock '" << m_clock_name << "' ";
+  format_stats(os,m_stats->total);
+  os << " wait_cycles_log2=";
+  format_waits(os,m_stats->total);
+  for (const auto& entry : m_stats->by_process) {
+    os << "\n  " << entry.second.name << ": ";
+    format_stats(os,entry.second.stats);
+    os << " wait_cycles_log2=";
+    format_waits(os,entry.second.stats);
+  }//endfor
+  SC_REPORT_INFO("/xeda/no_clock/stats",os.str().c_str());
 }
 
 // TAF!
@@ -0,0 +1,139 @@
+#include "no_clock_bank.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+// DESCRIPTION
+// Struct-of-arrays clock table. See no_clock_bank.hpp.
+
+///////////////////////////////////////////////////////////////////////////////
+// $License: Apache 2.0 $
+//
+// This file is licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <systemc>
+using namespace sc_core;
+using namespace std;
+
+//------------------------------------------------------------------------------
+no_clock_bank::no_clock_bank //< Constructor
+( const char* instance, size_t reserve )
+: sc_object(instance)
+{
+  m_period.reserve(reserve);
+  m_posedge.reserve(reserve);
+  m_negedge.reserve(reserve);
+  m_sample.reserve(reserve);
+  m_setedge.reserve(reserve);
+  m_frequency_set.reserve(reserve);
+  m_base_count.reserve(reserve);
+  m_companion.reserve(reserve);
+}
+
+//------------------------------------------------------------------------------
+no_clock_bank::~no_clock_bank //< Destructor
+( void )
+{
+  for (size_t i = 0; i != m_companion.size(); ++i) delete m_companion[i];
+}
+
+//------------------------------------------------------------------------------
+no_clock_bank::index_t no_clock_bank::add
+( const char*    clock_name
+, const sc_time& tPERIOD
+, double         duty
+, const sc_time& tOFFSET
+, bool           positive
+)
+{
+  if (tPERIOD <= SC_ZERO_TIME) {
+    SC_REPORT_FATAL("/xeda/no_clock","Clocks must have a positive non-zero period.");
+  }//endif
+  if (duty <= 0.0 or 1.0 <= duty) {
+    SC_REPORT_FATAL("/xeda/no_clock","Duty cycle must be greater than 0.0 and less than 1.0!");
+  }//endif
+  if (tOFFSET >= tPERIOD) {
+    SC_REPORT_FATAL("/xeda/no_clock","tOFFSET must be less than period.");
+  }//endif
+  // Same edges as the original no_clock constructor
+  const sc_dt::uint64 period = tPERIOD.value();
+  const sc_time tHIGH(tOFFSET+duty*tPERIOD);
+  const sc_time tLOW(tOFFSET+(1-duty)*tPERIOD);
+  m_period.push_back(period);
+  m_posedge.push_back((positive?tOFFSET:tHIGH).value() % period);
+  m_negedge.push_back((positive?tHIGH:tOFFSET).value() % period);
+  m_sample.push_back((positive?tOFFSET:tLOW).value() % period);
+  m_setedge.push_back((positive?tHIGH:tOFFSET).value() % period);
+  m_frequency_set.push_back(sc_time_stamp().value());
+  m_base_count.push_back(0);
+  m_name.push_back(clock_name);
+  m_companion.push_back(nullptr);
+  return m_period.size() - 1;
+}
+
+//------------------------------------------------------------------------------
+// Like no_clock::set_period_time, keeping each edge at its fraction of the period
+void no_clock_bank::set_period_time
+( index_t i, const sc_time& tPERIOD )
+{
+  if (tPERIOD <= SC_ZERO_TIME) {
+    SC_REPORT_FATAL("/xeda/no_clock","Clocks must have a positive non-zero period.");
+  }//endif
+  const sc_dt::uint64 period = tPERIOD.value();
+  const double        ratio  = double(period) / double(m_period[i]);
+  m_base_count[i]    = cycles(i);
+  m_frequency_set[i] = sc_time_stamp().value();
+  m_posedge[i]       = sc_dt::uint64(m_posedge[i] * ratio + 0.5) % period;
+  m_negedge[i]       = sc_dt::uint64(m_negedge[i] * ratio + 0.5) % period;
+  m_sample[i]        = sc_dt::uint64(m_sample[i]  * ratio + 0.5) % period;
+  m_setedge[i]       = sc_dt::uint64(m_setedge[i] * ratio + 0.5) % period;
+  m_period[i]        = period;
+  if (m_companion[i] != nullptr) sync(i);
+}
+
+void no_clock_bank::set_frequency
+( index_t i, double frequency )
+{
+  if (frequency <= 0.0) {
+    SC_REPORT_FATAL("/xeda/no_clock","Clocks must have a positive non-zero frequency.");
+  }//endif
+  set_period_time(i, sc_time(1.0/frequency, SC_SEC));
+}
+
+//------------------------------------------------------------------------------
+// Compatibility events live in a companion no_clock made on first use
+sc_event& no_clock_bank::edge_event
+( index_t i, edge_kind kind, size_t events )
+{
+  if (m_companion[i] == nullptr) {
+    m_companion[i] = new no_clock(m_name[i].c_str(), period(i));
+    sync(i);
+  }//endif
+  return m_companion[i]->edge_event(kind,events);
+}
+
+//------------------------------------------------------------------------------
+void no_clock_bank::sync
+( index_t i )
+{
+  no_clock& companion(*m_companion[i]);
+  companion.m_tPERIOD  = sc_time::from_value(m_period[i]);
+  companion.m_posedge  = true;
+  companion.m_tOFFSET  = sc_time::from_value(m_posedge[i]);
+  companion.m_tPOSEDGE = sc_time::from_value(m_posedge[i]);
+  companion.m_tNEGEDGE = sc_time::from_value(m_negedge[i]);
+  companion.m_tSAMPLE  = sc_time::from_value(m_sample[i]);
+  companion.m_tSETEDGE = sc_time::from_value(m_setedge[i]);
+  companion.m_duty     = double((m_period[i] + m_negedge[i] - m_posedge[i]) % m_period[i]) / double(m_period[i]);
+  companion.update_ticks(); // reschedules the events if subscribed
+}
+
+// TAF!
@@ -0,0 +1,284 @@
+#include "no_clock.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+// DESCRIPTION
+// Checkpoint/restore of no_clock state (see no_clock::save and no_clock::restore).
+//
+// Record layout (every integer is 64 bit little endian, so files move between hosts):
+//   magic "NOCLOCK1", ticks per second, name length, name bytes,
+//   flags, period, duty (IEEE bits), offset, sample, setedge, shift,
+//   mul, div, period num, period den, frequency changes, cycle count,
+//   save time, ticks into the current cycle, history depth,
+//   modulation frame length, modulation periods...
+// The registry (save_global) is "NOCLOCKG", the number of records, then records.
+
+///////////////////////////////////////////////////////////////////////////////
+// $License: Apache 2.0 $
+//
+// This file is licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <systemc>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+using namespace sc_core;
+using namespace std;
+
+struct no_clock::checkpoint_t
+{
+  enum { POSITIVE = 1, GATED = 2, DERIVED = 4, RATIONAL = 8, MODULATED = 16 };
+  string                name;
+  sc_dt::uint64         flags;
+  sc_dt::uint64         period, offset, sample, setedge, shift; // ticks
+  double                duty;
+  Clock_count_t         mul, div;
+  sc_dt::uint64         num, den;
+  Clock_count_t         freq_count;
+  Clock_count_t         count;   // cycles() at save
+  sc_dt::uint64         time;    // sc_time_stamp() at save
+  sc_dt::uint64         elapsed; // ticks since the (root) count last advanced
+  sc_dt::uint64         history_depth;
+  vector<sc_dt::uint64> modulation;
+};
+
+namespace {
+  const char RECORD_MAGIC[]   = "NOCLOCK1";
+  const char REGISTRY_MAGIC[] = "NOCLOCKG";
+  const sc_dt::uint64 MAX_NAME       = 1U << 16; // sanity limits for corrupt input
+  const sc_dt::uint64 MAX_MODULATION = 1U << 30;
+
+  void put ( ostream& os, sc_dt::uint64 value )
+  {
+    char bytes[8];
+    for (int i = 0; i != 8; ++i) bytes[i] = char( (value >> (8*i)) & 0xFF );
+    os.write(bytes,8);
+  }
+  bool get ( istream& is, sc_dt::uint64& value )
+  {
+    unsigned char bytes[8];
+    if (not is.read(reinterpret_cast<char*>(bytes),8)) return false;
+    value = 0;
+    for (int i = 0; i != 8; ++i) value |= sc_dt::uint64(bytes[i]) << (8*i);
+    return true;
+  }
+  bool get_magic ( istream& is, const char* magic )
+  {
+    char bytes[8];
+    return is.read(bytes,8) and memcmp(bytes,magic,8) == 0;
+  }
+  sc_dt::uint64 ticks_per_second ( void )
+  {
+    return sc_time(1,SC_SEC).value();
+  }
+  bool fail ( const char* message ) // a warning, so that the caller really gets false back
+  {
+    SC_REPORT_WARNING("/xeda/no_clock/checkpoint",message);
+    return false;
+  }
+}
+
+//------------------------------------------------------------------------------
+void no_clock::save
+( ostream& os ) const
+{
+  const sc_dt::uint64 now = sc_time_stamp().value();
+  sc_dt::uint64 duty_bits;
+  memcpy(&duty_bits,&m_duty,sizeof(duty_bits));
+  sc_dt::uint64 flags = 0;
+  if (m_posedge)      flags |= checkpoint_t::POSITIVE;
+  if (m_gated)        flags |= checkpoint_t::GATED;
+  if (m_root)         flags |= checkpoint_t::DERIVED;
+  const no_clock& counter(m_root ? *m_root : *this); // derived clocks rebase with their root
+  if (counter.is_rational())  flags |= checkpoint_t::RATIONAL;
+  if (counter.is_modulated()) flags |= checkpoint_t::MODULATED;
+  const sc_dt::uint64 elapsed = (counter.m_gated or counter.m_irregular) ? 0
+                              : (now - counter.m_frequency_set.value()) % counter.m_period_ticks;
+  const string name(m_clock_name);
+  os.write(RECORD_MAGIC,8);
+  put(os, ticks_per_second());
+  put(os, name.size());
+  os.write(name.data(),name.size());
+  put(os, flags);
+  put(os, m_period_ticks);
+  put(os, duty_bits);
+  put(os, m_tOFFSET.value());
+  put(os, m_tSAMPLE.value());
+  put(os, m_tSETEDGE.value());
+  put(os, m_tSHIFT.value());
+  put(os, m_mul);
+  put(os, m_div);
+  put(os, m_period_num);
+  put(os, m_period_den);
+  put(os, m_freq_count);
+  put(os, cycles(sc_time_stamp()));
+  put(os, now);
+  put(os, elapsed);
+  put(os, m_history_depth);
+  put(os, m_mod_period.size());
+  for (size_t k = 0; k != m_mod_period.size(); ++k) put(os, m_mod_period[k]);
+}
+
+//------------------------------------------------------------------------------
+bool no_clock::restore
+( istream& is )
+{
+  checkpoint_t saved;
+  if (not read_checkpoint(is,saved)) return false;
+  if (saved.name != m_clock_name) {
+    string message("Restoring clock '");
+    message += m_clock_name;
+    message += "' from a checkpoint of '";
+    message += saved.name;
+    message += "'";
+    SC_REPORT_WARNING("/xeda/no_clock/checkpoint",message.c_str());
+  }//endif
+  if (bool(saved.flags & checkpoint_t::DERIVED) != (m_root != nullptr)) {
+    return fail("Checkpoint of a derived clock must be restored into a derived clock (and vice versa).");
+  }//endif
+  if ((saved.flags & checkpoint_t::MODULATED) and m_root == nullptr and not m_derived.empty()) {
+    return fail("Checkpoint of a modulated clock cannot be restored into a clock with derived clocks.");
+  }//endif
+  if ((saved.flags & checkpoint_t::RATIONAL) and m_root == nullptr and not m_derived.empty()) {
+    return fail("Checkpoint of a rational clock cannot be restored into a clock with derived clocks.");
+  }//endif
+  if (m_root != nullptr and (saved.mul != m_mul or saved.div != m_div or saved.period != m_period_ticks)) {
+    return fail("Derived clock ratio differs from the checkpoint; restore the root clock first.");
+  }//endif
+  rebase(saved);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Translate the saved timeline so that the start of the cycle in progress lands
+// on sc_time_stamp(): edges rotate within the period, the count carries on from
+// there (this always fits, even when restoring at time 0). Rational and modulated
+// periods restart their frame instead, and derived clocks rotate with their root.
+// Gating is assigned as saved, so waiters and events only wake if it really ends.
+void no_clock::rebase
+( const checkpoint_t& saved )
+{
+  before_change();
+  const bool          was_gated = m_gated;
+  const sc_dt::uint64 now    = sc_time_stamp().value();
+  const sc_dt::uint64 period = saved.period;
+  const bool          exact  = not (saved.flags & (checkpoint_t::RATIONAL | checkpoint_t::MODULATED));
+  const sc_dt::uint64 start  = saved.time - saved.elapsed; // cycle in progress began
+  const sc_dt::uint64 rotate = exact ? (now % period + period - start % period) % period : 0;
+  m_tPERIOD  = sc_time::from_value(period);
+  m_duty     = saved.duty;
+  m_posedge  = (saved.flags & checkpoint_t::POSITIVE) != 0;
+  m_tOFFSET  = sc_time::from_value( (saved.offset + rotate) % period );
+  m_tSAMPLE  = sc_time::from_value( (saved.sample + rotate) % period );
+  m_tSETEDGE = sc_time::from_value( (saved.setedge + rotate) % period );
+  m_tSHIFT   = sc_time::from_value(saved.shift);
+  m_tPOSEDGE = (m_posedge)?(m_tOFFSET):(m_tOFFSET+m_duty*m_tPERIOD);
+  m_tNEGEDGE = (m_posedge)?(m_tOFFSET+m_duty*m_tPERIOD):(m_tOFFSET);
+  if (m_root != nullptr) { // counts with the root
+    update_ticks();
+    set_follow_base();
+    m_timing_changed_event.notify(SC_ZERO_TIME);
+    return;
+  }//endif
+  m_period_num = saved.num;
+  m_period_den = saved.den;
+  m_mod_period = saved.modulation;
+  m_mod_start.clear();
+  if (not m_mod_period.empty()) {
+    m_mod_start.assign(1,0);
+    for (size_t k = 0; k != m_mod_period.size(); ++k) m_mod_start.push_back(m_mod_start.back() + m_mod_period[k]);
+  }//endif
+  m_mod_origin    = now;
+  m_freq_count    = saved.freq_count;
+  m_history_depth = saved.history_depth;
+  m_gated         = (saved.flags & checkpoint_t::GATED) != 0;
+  m_history.clear();
+  m_history_trimmed = false;
+  m_base_count    = saved.count;
+  m_frequency_set = sc_time::from_value(now);
+  record_segment();
+  update_ticks(); // also reschedules the compatibility events (none while gated)
+  for (size_t i = 0; i != m_derived.size(); ++i) {
+    m_derived[i]->m_gated = m_gated;
+    m_derived[i]->follow_root();
+  }//endfor
+  if (was_gated and not m_gated) {
+    release_gated();
+    for (size_t i = 0; i != m_derived.size(); ++i) m_derived[i]->release_gated();
+  }//endif
+  m_timing_changed_event.notify(SC_ZERO_TIME);
+}
+
+//------------------------------------------------------------------------------
+void no_clock::save_global
+( ostream& os )
+{
+  os.write(REGISTRY_MAGIC,8);
+  put(os, s_handles.size());
+  for (size_t i = 0; i != s_handles.size(); ++i) s_handles[i]->save(os);
+}
+
+//------------------------------------------------------------------------------
+bool no_clock::restore_global
+( istream& is )
+{
+  sc_dt::uint64 n;
+  if (not get_magic(is,REGISTRY_MAGIC) or not get(is,n)) return fail("Not a no_clock registry checkpoint.");
+  for (sc_dt::uint64 i = 0; i != n; ++i) {
+    checkpoint_t saved;
+    if (not read_checkpoint(is,saved)) return false;
+    if (saved.flags & checkpoint_t::DERIVED) return fail("Global clocks cannot be derived clocks.");
+    clock_map_t::const_iterator it(s_global.find(saved.name));
+    no_clock* clock_ptr = (it != s_global.end())
+      ? s_handles[it->second]
+      : global(saved.name.c_str(), sc_time::from_value(saved.period), saved.duty);
+    clock_ptr->rebase(saved);
+  }//endfor
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool no_clock::read_checkpoint
+( istream& is, checkpoint_t& saved )
+{
+  sc_dt::uint64 resolution, length, duty_bits, n;
+  if (not get_magic(is,RECORD_MAGIC)) return fail("Not a no_clock checkpoint.");
+  if (not get(is,resolution) or not get(is,length) or length > MAX_NAME) return fail("Truncated no_clock checkpoint.");
+  if (resolution != ticks_per_second()) return fail("Checkpoint was saved with a different time resolution.");
+  saved.name.resize(length);
+  if (length != 0 and not is.read(&saved.name[0],length)) return fail("Truncated no_clock checkpoint.");
+  if (not ( get(is,saved.flags)     and get(is,saved.period)     and get(is,duty_bits)
+        and get(is,saved.offset)    and get(is,saved.sample)     and get(is,saved.setedge)
+        and get(is,saved.shift)     and get(is,saved.mul)        and get(is,saved.div)
+        and get(is,saved.num)       and get(is,saved.den)        and get(is,saved.freq_count)
+        and get(is,saved.count)     and get(is,saved.time)       and get(is,saved.elapsed)
+        and get(is,saved.history_depth) and get(is,n) and n <= MAX_MODULATION )) {
+    return fail("Truncated no_clock checkpoint.");
+  }//endif
+  memcpy(&saved.duty,&duty_bits,sizeof(saved.duty));
+  saved.modulation.resize(n);
+  for (sc_dt::uint64 k = 0; k != n; ++k) {
+    if (not get(is,saved.modulation[k])) return fail("Truncated no_clock checkpoint.");
+    if (saved.modulation[k] == 0) return fail("Corrupt no_clock checkpoint (zero modulation period).");
+  }//endfor
+  if (saved.period == 0 or saved.den == 0 or not (0.0 < saved.duty and saved.duty < 1.0)
+   or saved.time < saved.elapsed) {
+    return fail("Corrupt no_clock checkpoint.");
+  }//endif
+  if (not (saved.flags & checkpoint_t::DERIVED) and (n != 0) != bool(saved.flags & checkpoint_t::MODULATED)) {
+    return fail("Corrupt no_clock checkpoint.");
+  }//endif
+  return true;
+}
+
+// TAF!
@@ -0,0 +1,241 @@
+#include "no_clock.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+// DESCRIPTION
+// Startup configuration of no_clock timing (see no_clock::configure).
+
+///////////////////////////////////////////////////////////////////////////////
+// $License: Apache 2.0 $
+//
+// This file is licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <systemc>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+using namespace sc_core;
+using namespace std;
+
+namespace {
+  typedef unordered_map<string,string> settings_t; // "<name>.<key>" -> value
+
+  string trim ( const string& text )
+  {
+    const size_t first = text.find_first_not_of(" \t\r\n");
+    if (first == string::npos) return string();
+    return text.substr(first, text.find_last_not_of(" \t\r\n") - first + 1);
+  }
+
+  void add_setting ( settings_t& settings, const string& setting )
+  {
+    const string text(trim(setting.substr(0,setting.find('#'))));
+    if (text.empty()) return;
+    const size_t equals = text.find('=');
+    const string name(trim(text.substr(0,equals)));
+    if (equals == string::npos or name.find('.') == string::npos) {
+      string message("Ignoring clock setting '");
+      message += text;
+      message += "' (expected <name>.<key>=<value>)";
+      SC_REPORT_ERROR("/xeda/no_clock/config",message.c_str());
+      return;
+    }//endif
+    settings[name] = trim(text.substr(equals+1));
+  }
+
+  void add_settings ( settings_t& settings, const string& text )
+  {
+    size_t start = 0;
+    while (start <= text.size()) {
+      const size_t end = text.find_first_of(";\n",start);
+      add_setting(settings, text.substr(start, end == string::npos ? string::npos : end - start));
+      if (end == string::npos) break;
+      start = end + 1;
+    }//endwhile
+  }
+
+  bool add_file ( settings_t& settings, const char* file_name )
+  {
+    ifstream file(file_name);
+    if (not file) {
+      string message("Unable to read clock configuration file '");
+      message += file_name;
+      message += "'";
+      SC_REPORT_ERROR("/xeda/no_clock/config",message.c_str());
+      return false;
+    }//endif
+    string line;
+    while (getline(file,line)) add_setting(settings,line);
+    return true;
+  }
+
+  // Environment first (once), so that configure() calls win
+  settings_t& settings ( void )
+  {
+    static settings_t* s_settings = nullptr;
+    if (s_settings == nullptr) {
+      s_settings = new settings_t;
+      if (const char* file_name = getenv("NO_CLOCK_CONFIG")) add_file(*s_settings,file_name);
+      if (const char* text      = getenv("NO_CLOCK_SET"))    add_settings(*s_settings,text);
+    }//endif
+    return *s_settings;
+  }
+
+  // "<number> <unit>" with unit fs..s, or for frequencies Hz..GHz (space optional)
+  bool parse_number ( const string& value, double& number, string& unit )
+  {
+    const char* begin = value.c_str();
+    char*       end   = nullptr;
+    number = strtod(begin,&end);
+    if (end == begin) return false;
+    unit = trim(string(end));
+    return true;
+  }
+
+  bool parse_time ( const string& value, sc_time& t )
+  {
+    static const struct { const char* name; sc_time_unit unit; } units[] =
+      { {"fs",SC_FS}, {"ps",SC_PS}, {"ns",SC_NS}, {"us",SC_US}, {"ms",SC_MS}, {"s",SC_SEC}, {"sec",SC_SEC} };
+    double number;
+    string unit;
+    if (not parse_number(value,number,unit) or number < 0.0) return false;
+    for (size_t i = 0; i != sizeof(units)/sizeof(units[0]); ++i) {
+      if (unit == units[i].name) { t = sc_time(number,units[i].unit); return true; }
+    }//endfor
+    return false;
+  }
+
+  bool parse_frequency ( const string& value, sc_time& period )
+  {
+    static const struct { const char* name; double scale; } units[] =
+      { {"Hz",1.0}, {"kHz",1.0e3}, {"MHz",1.0e6}, {"GHz",1.0e9} };
+    double number;
+    string unit;
+    if (not parse_number(value,number,unit) or number <= 0.0) return false;
+    for (size_t i = 0; i != sizeof(units)/sizeof(units[0]); ++i) {
+      if (unit == units[i].name) { period = sc_time(1.0/(number*units[i].scale),SC_SEC); return true; }
+    }//endfor
+    return false;
+  }
+
+  void bad_value ( const string& name, const string& key, const string& value )
+  {
+    string message("Ignoring clock setting ");
+    message += name + "." + key + "=" + value + " (not a valid value)";
+    SC_REPORT_ERROR("/xeda/no_clock/config",message.c_str());
+  }
+}
+
+//------------------------------------------------------------------------------
+void no_clock::configure
+( const string& text )
+{
+  add_settings(settings(),text);
+}
+
+void no_clock::configure
+( int argc, const char* const* argv )
+{
+  for (int i = 1; i < argc; ++i) {
+    if (strncmp(argv[i],"--no_clock=",11) == 0) {
+      add_setting(settings(),argv[i] + 11);
+    } else if (strcmp(argv[i],"-no_clock") == 0 and i+1 < argc) {
+      add_setting(settings(),argv[++i]);
+    }//endif
+  }//endfor
+}
+
+bool no_clock::configure_file
+( const char* file_name )
+{
+  return add_file(settings(),file_name);
+}
+
+//------------------------------------------------------------------------------
+// Constructor tail: the arguments (not yet validated when deferred) are replaced
+// by any matching settings, and the result is validated like the arguments were.
+// default_edges: sample and setedge were computed from offset and duty (original
+// constructor) and are computed again unless set explicitly.
+void no_clock::apply_config
+( bool default_edges )
+{
+  const settings_t& table(settings());
+  if (table.empty()) return;
+  string hierarchical(m_clock_name);
+  if (const sc_object* parent = get_parent_object()) hierarchical = string(parent->name()) + "." + m_clock_name;
+  const string names[] = { hierarchical, string(m_clock_name), string("*") }; // most specific first
+  const char*  keys[]  = { "period", "duty", "offset", "sample", "setedge" };
+  bool applied = false, sample_set = false, setedge_set = false;
+  for (size_t k = 0; k != sizeof(keys)/sizeof(keys[0]); ++k) {
+    string key(keys[k]);
+    settings_t::const_iterator it(table.end());
+    size_t n = 0;
+    for (; n != 3 and it == table.end(); ++n) {
+      it = table.find(names[n] + "." + key);
+      if (it == table.end() and key == "period") { // one setting with frequency (period wins for the same name)
+        it = table.find(names[n] + ".frequency");
+        if (it != table.end()) key = "frequency";
+      }//endif
+    }//endfor
+    if (it == table.end()) continue;
+    const string& name(names[n-1]);
+    const string& value(it->second);
+    sc_time t;
+    if (key == "frequency" or key == "period") {
+      if (not (key == "frequency" ? parse_frequency(value,t) : parse_time(value,t)) or t <= SC_ZERO_TIME) {
+        bad_value(name,key,value);
+        continue;
+      }//endif
+      if (m_tPERIOD > SC_ZERO_TIME) { // keep edges at their fraction of the period
+        const double ratio = t / m_tPERIOD;
+        m_tOFFSET  = m_tOFFSET  * ratio;
+        m_tSAMPLE  = m_tSAMPLE  * ratio;
+        m_tSETEDGE = m_tSETEDGE * ratio;
+      }//endif
+      m_tPERIOD  = t;
+    } else if (key == "duty") {
+      char* end = nullptr;
+      const double duty = strtod(value.c_str(),&end);
+      if (end == value.c_str() or not trim(end).empty() or duty <= 0.0 or 1.0 <= duty) {
+        bad_value(name,key,value);
+        continue;
+      }//endif
+      m_duty = duty;
+    } else if (not parse_time(value,t) or t >= m_tPERIOD) {
+      bad_value(name,key,value);
+      continue;
+    } else if (key == "offset") {
+      m_tOFFSET = t;
+    } else if (key == "sample") {
+      m_tSAMPLE  = t;
+      sample_set = true;
+    } else {
+      m_tSETEDGE  = t;
+      setedge_set = true;
+    }//endif
+    applied = true;
+    string message("Clock '");
+    message += hierarchical + "' " + key + " set to " + value + " by " + it->first;
+    SC_REPORT_INFO("/xeda/no_clock/config",message.c_str());
+  }//endfor
+  if (not applied) return;
+  m_tPOSEDGE = (m_posedge)?(m_tOFFSET):(m_tOFFSET+m_duty*m_tPERIOD);
+  m_tNEGEDGE = (m_posedge)?(m_tOFFSET+m_duty*m_tPERIOD):(m_tOFFSET);
+  if (default_edges and not sample_set)  m_tSAMPLE  = m_posedge?(m_tOFFSET):(m_tOFFSET+(1-m_duty)*m_tPERIOD);
+  if (default_edges and not setedge_set) m_tSETEDGE = m_posedge?(m_tOFFSET+m_duty*m_tPERIOD):(m_tOFFSET);
+  if (not s_defer) validate(); // otherwise validate_deferred checks the result
+}
+
+// TAF!
@@ -0,0 +1,168 @@
+#define SC_INCLUDE_DYNAMIC_PROCESSES
+#include "no_clock_scheduler.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+// DESCRIPTION
+// Drives the no_clock compatibility events for all clocks from one shared
+// SC_METHOD. See no_clock_scheduler.hpp.
+
+///////////////////////////////////////////////////////////////////////////////
+// $License: Apache 2.0 $
+//
+// This file is licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <systemc>
+#include <algorithm>
+using namespace sc_core;
+using namespace std;
+
+no_clock_scheduler* no_clock_scheduler::s_instance = nullptr;
+
+//------------------------------------------------------------------------------
+no_clock_scheduler& no_clock_scheduler::instance
+( void )
+{
+  // Never destroyed: sc_event may not outlive the simulation context
+  if (s_instance == nullptr) s_instance = new no_clock_scheduler();
+  return *s_instance;
+}
+
+//------------------------------------------------------------------------------
+no_clock_scheduler::no_clock_scheduler //< Constructor
+( void )
+: m_armed(0)
+, m_is_armed(false)
+, m_notifications(0)
+{
+  sc_spawn_options opts;
+  opts.spawn_method();
+  opts.dont_initialize();
+  opts.set_sensitivity(&m_wakeup);
+  sc_spawn([this](){ fire(); }, "no_clock_scheduler", &opts);
+}
+
+//------------------------------------------------------------------------------
+// On behalf of the process declared last (sensitive << clk.posedge_event() follows
+// SC_METHOD/SC_THREAD), which sc_get_current_process_handle() returns while elaborating
+void no_clock_scheduler::subscribe
+( no_clock& clock, no_clock::edge_kind kind )
+{
+  const sc_process_handle process(sc_get_current_process_handle());
+  bool known = false;
+  for (size_t i = 0; i != clock.m_sensitive.size() and not known; ++i) {
+    known = clock.m_sensitive[i].kind == kind and clock.m_sensitive[i].process == process;
+  }//endfor
+  if (not known) {
+    const no_clock::sensitive_t owner = { kind, process };
+    clock.m_sensitive.push_back(owner);
+  }//endif
+  const unsigned bit = 1U << kind;
+  if (clock.m_subscribed & bit) return;
+  clock.m_subscribed |= bit;
+  if (clock.m_gated) return; // scheduled by ungate()
+  // First edge may be right now (e.g. posedge at time zero)
+  schedule(clock, kind, clock.edge_ticks(kind,sc_time_stamp().value(),true));
+  wakeup();
+}
+
+//------------------------------------------------------------------------------
+void no_clock_scheduler::reschedule
+( no_clock& clock )
+{
+  ++clock.m_schedule_generation; // existing entries become stale
+  if (clock.m_gated) return; // quiet until ungate()
+  const sc_dt::uint64 now = sc_time_stamp().value();
+  for (unsigned kind = no_clock::POSEDGE; kind <= no_clock::SETEDGE; ++kind) {
+    if (clock.m_subscribed & (1U << kind)) {
+      schedule(clock, no_clock::edge_kind(kind), clock.edge_ticks(no_clock::edge_kind(kind),now));
+    }//endif
+  }//endfor
+  wakeup();
+}
+
+//------------------------------------------------------------------------------
+// Entries (stale ones included) hold a plain pointer, so they must go before the
+// clock does; m_wakeup may stay armed for one of them, which fire() tolerates
+void no_clock_scheduler::forget
+( no_clock& clock )
+{
+  if (s_instance == nullptr) return; // nothing was ever scheduled
+  vector<entry_t>& pending(s_instance->m_pending);
+  const no_clock* gone = &clock;
+  pending.erase(remove_if(pending.begin(), pending.end(), [gone](const entry_t& entry){ return entry.clock == gone; })
+               , pending.end());
+  make_heap(pending.begin(), pending.end(), later_t());
+}
+
+//------------------------------------------------------------------------------
+// An edge stays subscribed while one of its owners has not terminated (and for
+// good if it was requested before any process existed)
+bool no_clock_scheduler::sensitive
+( no_clock& clock, no_clock::edge_kind kind )
+{
+  vector<no_clock::sensitive_t>& owners(clock.m_sensitive);
+  for (size_t i = 0; i != owners.size(); ) {
+    if (owners[i].kind != kind) {
+      ++i;
+    } else if (not owners[i].process.valid() or not owners[i].process.terminated()) {
+      return true;
+    } else {
+      owners.erase(owners.begin() + i);
+    }//endif
+  }//endfor
+  clock.m_subscribed &= ~(1U << kind); // from now on requested one at a time
+  return false;
+}
+
+//------------------------------------------------------------------------------
+void no_clock_scheduler::schedule
+( no_clock& clock, no_clock::edge_kind kind, sc_dt::uint64 when )
+{
+  entry_t entry = { when, &clock, kind, clock.m_schedule_generation };
+  m_pending.push_back(entry);
+  push_heap(m_pending.begin(), m_pending.end(), later_t());
+}
+
+//------------------------------------------------------------------------------
+void no_clock_scheduler::wakeup
+( void )
+{
+  if (m_pending.empty()) return;
+  const sc_dt::uint64 when = m_pending.front().when;
+  if (m_is_armed and m_armed <= when) return; // already wakes up early enough
+  // A later pending notification is overridden by an earlier one
+  m_wakeup.notify(sc_time::from_value(when - sc_time_stamp().value()));
+  m_armed    = when;
+  m_is_armed = true;
+}
+
+//------------------------------------------------------------------------------
+void no_clock_scheduler::fire
+( void )
+{
+  const sc_dt::uint64 now = sc_time_stamp().value();
+  m_is_armed = false;
+  while (not m_pending.empty() and m_pending.front().when <= now) {
+    pop_heap(m_pending.begin(), m_pending.end(), later_t());
+    const entry_t entry = m_pending.back();
+    m_pending.pop_back();
+    if (entry.generation != entry.clock->m_schedule_generation) continue; // stale
+    if (not sensitive(*entry.clock, entry.kind)) continue; // every owner has terminated
+    entry.clock->edge_event_ref(entry.kind).notify();
+    ++m_notifications;
+    schedule(*entry.clock, entry.kind, entry.clock->edge_ticks(entry.kind,now));
+  }//endwhile
+  wakeup();
+}
+
+// TAF!
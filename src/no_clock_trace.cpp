@@ -0,0 +1,245 @@
+#include "no_clock_trace.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+// DESCRIPTION
+// Analytic VCD writer for no_clock. See no_clock_trace.hpp.
+
+///////////////////////////////////////////////////////////////////////////////
+// $License: Apache 2.0 $
+//
+// This file is licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <systemc>
+#include <algorithm>
+using namespace sc_core;
+using namespace std;
+
+vector<no_clock_trace*> no_clock_trace::s_files;
+
+namespace {
+  const size_t CHUNK = 1U << 16; // bytes per write
+}
+
+//------------------------------------------------------------------------------
+no_clock_trace::no_clock_trace //< Constructor
+( const char* file_name )
+: sc_prim_channel(sc_gen_unique_name("no_clock_trace"))
+, m_file((string(file_name) + ".vcd").c_str())
+, m_flushed(sc_time_stamp().value())
+, m_last_time(0)
+, m_started(false)
+{
+  if (not m_file) {
+    string message("Unable to open VCD file '");
+    message += file_name;
+    message += ".vcd'";
+    SC_REPORT_ERROR("/xeda/no_clock/trace",message.c_str());
+  }//endif
+  m_buffer.reserve(2*CHUNK);
+  s_files.push_back(this);
+  no_clock::s_change_hook = &change_hook;
+}
+
+//------------------------------------------------------------------------------
+no_clock_trace::~no_clock_trace //< Destructor
+( void )
+{
+  if (not m_started) write_header(); // closed before simulation: initial values only
+  flush();
+  s_files.erase(find(s_files.begin(),s_files.end(),this));
+  if (s_files.empty()) no_clock::s_change_hook = nullptr;
+}
+
+//------------------------------------------------------------------------------
+void no_clock_trace::trace
+( const no_clock& clock, const string& name )
+{
+  if (m_started) {
+    SC_REPORT_ERROR("/xeda/no_clock/trace","Clocks must be traced before simulation starts (or, while simulating, before the file is first flushed).");
+    return;
+  }//endif
+  // VCD identifier codes: printable characters '!'..'~' in base 94
+  string id;
+  size_t n = m_signals.size();
+  do { id += char('!' + n % 94); n /= 94; } while (n != 0);
+  signal_t signal = { &clock, name, id, 0, 0, false };
+  m_signals.push_back(signal);
+}
+
+//------------------------------------------------------------------------------
+void no_clock_trace::flush
+( void )
+{
+  if (not m_started and not sc_is_running()) return; // nothing to write before simulation
+  flush_until(sc_time_stamp().value());
+  drain();
+  m_file.flush();
+}
+
+//------------------------------------------------------------------------------
+// The signals are fixed from here on; a file created while simulating starts at
+// its first flush instead
+void no_clock_trace::start_of_simulation
+( void )
+{
+  if (not m_started) write_header();
+}
+
+//------------------------------------------------------------------------------
+bool no_clock_trace::traces
+( const no_clock& clock ) const
+{
+  for (size_t i = 0; i != m_signals.size(); ++i) {
+    if (m_signals[i].clock == &clock) return true;
+  }//endfor
+  return false;
+}
+
+//------------------------------------------------------------------------------
+void no_clock_trace::write_header
+( void )
+{
+  m_started = true;
+  m_file << "$version no_clock_trace $end\n"
+         << "$timescale " << sc_get_time_resolution().to_string() << " $end\n"
+         << "$scope module no_clock $end\n";
+  for (size_t i = 0; i != m_signals.size(); ++i) {
+    m_file << "$var wire 1 " << m_signals[i].id << " " << m_signals[i].name << " $end\n";
+  }//endfor
+  m_file << "$upscope $end\n$enddefinitions $end\n";
+  m_buffer += "#" + to_string(m_flushed) + "\n$dumpvars\n";
+  m_last_time = m_flushed;
+  for (size_t i = 0; i != m_signals.size(); ++i) {
+    signal_t& signal(m_signals[i]);
+    const no_clock& clock(*signal.clock);
+    signal.value = not clock.gated()
+               and clock.edge_ticks(no_clock::NEGEDGE,m_flushed) < clock.edge_ticks(no_clock::POSEDGE,m_flushed);
+    m_buffer += (signal.value ? '1' : '0') + signal.id + "\n";
+  }//endfor
+  m_buffer += "$end\n";
+}
+
+//------------------------------------------------------------------------------
+// Merge the edges of all signals in (m_flushed,t]; timing is constant over that
+// interval since every change flushes first
+void no_clock_trace::flush_until
+( sc_dt::uint64 t )
+{
+  if (not m_started) write_header();
+  if (t < m_flushed) return;
+  const sc_dt::uint64 NONE = ~sc_dt::uint64(0);
+  for (size_t i = 0; i != m_signals.size(); ++i) {
+    signal_t& signal(m_signals[i]);
+    const no_clock& clock(*signal.clock);
+    if (clock.gated()) {
+      signal.posedge = signal.negedge = NONE; // held low
+      if (signal.value) { signal.value = false; emit(m_flushed,signal); }
+      continue;
+    }//endif
+    signal.posedge = clock.edge_ticks(no_clock::POSEDGE,m_flushed);
+    signal.negedge = clock.edge_ticks(no_clock::NEGEDGE,m_flushed);
+    const bool value = signal.negedge < signal.posedge;
+    if (value != signal.value) { signal.value = value; emit(m_flushed,signal); } // e.g. just ungated
+  }//endfor
+  for (;;) {
+    size_t        next = m_signals.size();
+    sc_dt::uint64 when = NONE;
+    for (size_t i = 0; i != m_signals.size(); ++i) {
+      const sc_dt::uint64 edge = min(m_signals[i].posedge,m_signals[i].negedge);
+      if (edge < when) { when = edge; next = i; }
+    }//endfor
+    if (next == m_signals.size() or when > t) break;
+    signal_t& signal(m_signals[next]);
+    const no_clock& clock(*signal.clock);
+    if (signal.posedge < signal.negedge) {
+      signal.value   = true;
+      signal.posedge = clock.edge_ticks(no_clock::POSEDGE,when);
+    } else {
+      signal.value   = false;
+      signal.negedge = clock.edge_ticks(no_clock::NEGEDGE,when);
+    }//endif
+    emit(when,signal);
+  }//endfor
+  m_flushed = t;
+}
+
+//------------------------------------------------------------------------------
+void no_clock_trace::emit
+( sc_dt::uint64 t, const signal_t& signal )
+{
+  if (t != m_last_time) {
+    m_buffer += '#';
+    m_buffer += to_string(t);
+    m_buffer += '\n';
+    m_last_time = t;
+  }//endif
+  m_buffer += signal.value ? '1' : '0';
+  m_buffer += signal.id;
+  m_buffer += '\n';
+  if (m_buffer.size() >= CHUNK) drain();
+}
+
+//------------------------------------------------------------------------------
+void no_clock_trace::drain
+( void )
+{
+  if (m_buffer.empty()) return;
+  m_file.write(m_buffer.data(), m_buffer.size());
+  m_buffer.clear();
+}
+
+//------------------------------------------------------------------------------
+// A destroyed clock leaves the file (its waveform stops where it was)
+void no_clock_trace::forget
+( const no_clock& clock )
+{
+  for (size_t i = 0; i != m_signals.size(); ) {
+    if (m_signals[i].clock == &clock) m_signals.erase(m_signals.begin() + i);
+    else ++i;
+  }//endfor
+}
+
+//------------------------------------------------------------------------------
+// Called by no_clock just before its timing changes (or it is destroyed); changes
+// during elaboration precede the header, so only the initial values record them
+void no_clock_trace::change_hook
+( const no_clock& clock, bool destroyed )
+{
+  for (size_t i = 0; i != s_files.size(); ++i) {
+    no_clock_trace& file(*s_files[i]);
+    if (not file.traces(clock)) continue;
+    if (file.m_started or sc_is_running()) file.flush_until(sc_time_stamp().value());
+    if (destroyed) file.forget(clock);
+  }//endfor
+}
+
+//------------------------------------------------------------------------------
+no_clock_trace* no_clock_create_vcd_trace_file
+( const char* file_name )
+{
+  return new no_clock_trace(file_name);
+}
+
+void no_clock_close_vcd_trace_file
+( no_clock_trace* tf )
+{
+  delete tf;
+}
+
+void sc_trace
+( no_clock_trace* tf, const no_clock& clock, const string& name )
+{
+  if (tf != nullptr) tf->trace(clock,name);
+}
+
+// TAF!